@@ -61,10 +61,16 @@ int main()
 
     std::pair<std::string, sort_f<std::vector, value_t>> sorts[] = {
         { "heap_sort",      cppsort::heap_sort      },
+        { "ips4o_sort",     cppsort::ips4o_sort     },
         { "pdq_sort",       cppsort::pdq_sort       },
+        { "quad_sort",      cppsort::quad_sort      },
         { "quick_sort",     cppsort::quick_sort     },
+        { "samplesort_sort", cppsort::samplesort_sort },
         { "spread_sort",    cppsort::spread_sort    },
         { "std_sort",       cppsort::std_sort       },
+        { "tim_sort",       cppsort::tim_sort       },
+        { "tim_powersort",  cppsort::basic_tim_sorter<cppsort::utility::powersort_merge_policy>{} },
+        { "tim_kway_sort",  cppsort::basic_tim_sorter<cppsort::utility::kway_merge_policy<>>{} },
         { "verge_sort",     cppsort::verge_sort     }
     };
 
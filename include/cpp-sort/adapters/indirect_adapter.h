@@ -27,16 +27,20 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <iterator>
+#include <limits>
+#include <numeric>
 #include <type_traits>
 #include <utility>
 #include <vector>
 #include <cpp-sort/sorter_facade.h>
 #include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/apply_permutation.h>
 #include <cpp-sort/utility/as_function.h>
 #include <cpp-sort/utility/functional.h>
-#include <cpp-sort/utility/iter_move.h>
 #include "../detail/checkers.h"
 #include "../detail/scope_exit.h"
 
@@ -51,89 +55,85 @@ namespace cppsort
         struct indirect_adapter_impl:
             check_is_always_stable<Sorter>
         {
-            template<
-                typename RandomAccessIterator,
-                typename Compare = std::less<>,
-                typename Projection = utility::identity,
-                typename = std::enable_if_t<is_projection_iterator_v<
-                    Projection, RandomAccessIterator, Compare
-                >>
-            >
-            auto operator()(RandomAccessIterator first, RandomAccessIterator last,
-                            Compare compare={}, Projection projection={}) const
-                -> decltype(auto)
-            {
-                using utility::iter_move;
-                auto&& proj = utility::as_function(projection);
+            private:
+
+                template<
+                    typename Index,
+                    typename RandomAccessIterator,
+                    typename Compare,
+                    typename Projection
+                >
+                static auto sort_indirectly(RandomAccessIterator first, RandomAccessIterator last,
+                                            Compare compare, Projection projection)
+                    -> decltype(auto)
+                {
+                    auto&& proj = utility::as_function(projection);
 
-                ////////////////////////////////////////////////////////////
-                // Indirectly sort the iterators
+                    ////////////////////////////////////////////////////////////
+                    // Indirectly sort the indices
 
-                // Copy the iterators in a vector
-                std::vector<RandomAccessIterator> iterators;
-                iterators.reserve(std::distance(first, last));
-                for (RandomAccessIterator it = first ; it != last ; ++it) {
-                    iterators.push_back(it);
-                }
+                    // Indices relative to first
+                    std::vector<Index> indices(std::distance(first, last));
+                    std::iota(std::begin(indices), std::end(indices), Index(0));
 
 #ifndef __cpp_lib_uncaught_exceptions
-                // Sort the iterators on pointed values
-                Sorter{}(std::begin(iterators), std::end(iterators), std::move(compare),
-                         [&proj](RandomAccessIterator it) -> decltype(auto) { return proj(*it); });
+                    // Sort the indices on pointed values
+                    Sorter{}(std::begin(indices), std::end(indices), std::move(compare),
+                             [&proj, &first](Index idx) -> decltype(auto) { return proj(first[idx]); });
 #else
-                // Work around the sorters that return void
-                auto exit_function = make_scope_success([&] {
+                    // Work around the sorters that return void
+                    auto exit_function = make_scope_success([&] {
 #endif
-                    ////////////////////////////////////////////////////////////
-                    // Move the values according the iterator's positions
-
-                    std::vector<bool> sorted(std::distance(first, last), false);
-
-                    // Element where the current cycle starts
-                    RandomAccessIterator start = first;
-
-                    while (start != last) {
-                        // Find the element to put in current's place
-                        RandomAccessIterator current = start;
-                        auto next_pos = std::distance(first, current);
-                        RandomAccessIterator next = iterators[next_pos];
-                        sorted[next_pos] = true;
-
-                        // Process the current cycle
-                        if (next != current) {
-                            auto tmp = iter_move(current);
-                            while (next != start) {
-                                *current = iter_move(next);
-                                current = next;
-                                auto next_pos = std::distance(first, next);
-                                next = iterators[next_pos];
-                                sorted[next_pos] = true;
-                            }
-                            *current = std::move(tmp);
-                        }
-
-                        // Find the next cycle
-                        do {
-                            ++start;
-                        } while (start != last && sorted[start - first]);
+                        ////////////////////////////////////////////////////////////
+                        // Move the values according the indices, the highest bit
+                        // of the indices marks the cycles that were processed
 
-                    }
+                        utility::detail::apply_permutation_cycles(std::begin(indices),
+                                                                  indices.size(),
+                                                                  first);
 #ifdef __cpp_lib_uncaught_exceptions
-                });
+                    });
 
-                if (first == last || std::next(first) == last) {
-                    exit_function.release();
-                }
+                    if (first == last || std::next(first) == last) {
+                        exit_function.release();
+                    }
 
-                return Sorter{}(std::begin(iterators), std::end(iterators), std::move(compare),
-                                [&proj](RandomAccessIterator it) -> decltype(auto) { return proj(*it); });
+                    return Sorter{}(std::begin(indices), std::end(indices), std::move(compare),
+                                    [&proj, &first](Index idx) -> decltype(auto) { return proj(first[idx]); });
 #endif
-            }
+                }
+
+            public:
+
+                template<
+                    typename RandomAccessIterator,
+                    typename Compare = std::less<>,
+                    typename Projection = utility::identity,
+                    typename = std::enable_if_t<is_projection_iterator_v<
+                        Projection, RandomAccessIterator, Compare
+                    >>
+                >
+                auto operator()(RandomAccessIterator first, RandomAccessIterator last,
+                                Compare compare={}, Projection projection={}) const
+                    -> decltype(auto)
+                {
+                    // Use 32-bit indices when possible to halve the memory
+                    // used by the indirect sort, one bit is used as a marker
+                    // when the permutation is applied
+                    auto size = std::distance(first, last);
+                    if (static_cast<std::uint_least64_t>(size) <=
+                        std::numeric_limits<std::uint32_t>::max() / 2) {
+                        return sort_indirectly<std::uint32_t>(std::move(first), std::move(last),
+                                                              std::move(compare), std::move(projection));
+                    }
+                    return sort_indirectly<std::size_t>(std::move(first), std::move(last),
+                                                        std::move(compare), std::move(projection));
+                }
 
-            ////////////////////////////////////////////////////////////
-            // Sorter traits
+                ////////////////////////////////////////////////////////////
+                // Sorter traits
 
-            using iterator_category = std::random_access_iterator_tag;
+                using iterator_category = std::random_access_iterator_tag;
         };
     }
 
@@ -27,8 +27,11 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <cstdint>
 #include <functional>
 #include <iterator>
+#include <limits>
 #include <memory>
 #include <tuple>
 #include <type_traits>
@@ -37,10 +40,15 @@
 #include <cpp-sort/sorter_traits.h>
 #include <cpp-sort/utility/as_function.h>
 #include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/iter_move.h>
 #include "../detail/associate_iterator.h"
 #include "../detail/checkers.h"
 #include "../detail/iterator_traits.h"
 #include "../detail/memory.h"
+#include "../detail/move.h"
+#include "../detail/projection_compare.h"
+#include "../detail/total_order_key.h"
+#include "../detail/type_traits.h"
 
 namespace cppsort
 {
@@ -104,6 +112,144 @@ namespace cppsort
             return { compare, projection };
         }
 
+        ////////////////////////////////////////////////////////////
+        // Key widening: integer keys of at most 32 bits are packed
+        // with their original position into a 64-bit integer, which
+        // makes every key unique; sorting these integers with the
+        // adapted sorter is then enough to get a stable order, and
+        // the collection is reordered afterwards
+
+        template<typename Compare>
+        struct is_widening_compare:
+            std::false_type
+        {};
+
+        template<>
+        struct is_widening_compare<std::less<>>:
+            std::true_type
+        {};
+
+        template<>
+        struct is_widening_compare<std::greater<>>:
+            std::true_type
+        {};
+
+        template<typename T>
+        struct is_widening_key:
+            std::integral_constant<
+                bool,
+                std::is_integral<T>::value &&
+                not std::is_same<T, bool>::value &&
+                sizeof(T) <= sizeof(std::uint32_t)
+            >
+        {};
+
+        template<typename Sorter>
+        using widened_sort_t = decltype(std::declval<Sorter&>()(
+            std::declval<std::uint64_t*>(), std::declval<std::uint64_t*>()
+        ));
+
+        template<typename Sorter, typename Iterator, typename Compare, typename Projection>
+        struct can_widen_keys:
+            conjunction<
+                std::is_base_of<std::random_access_iterator_tag, iterator_category_t<Iterator>>,
+                is_widening_compare<Compare>,
+                is_widening_key<projected_t<Iterator, Projection>>,
+                // The result of the adapted sorter is forwarded otherwise
+                std::is_same<detected_t<widened_sort_t, Sorter>, void>
+            >
+        {};
+
+        ////////////////////////////////////////////////////////////
+        // Stable sort with the adapted sorter
+
+        template<typename Sorter, typename Iterator, typename Compare, typename Projection>
+        auto stable_sort_impl(Iterator first, Iterator last,
+                              Compare compare, Projection projection, std::false_type)
+            -> decltype(Sorter{}(
+                make_associate_iterator(std::declval<association<Iterator, difference_type_t<Iterator>>*>()),
+                make_associate_iterator(std::declval<association<Iterator, difference_type_t<Iterator>>*>()),
+                make_stable_compare(std::move(compare), std::move(projection))
+            ))
+        {
+            using difference_type = difference_type_t<Iterator>;
+            using value_t = association<Iterator, difference_type>;
+
+            ////////////////////////////////////////////////////////////
+            // Bind index to iterator
+
+            auto size = std::distance(first, last);
+            std::unique_ptr<value_t, operator_deleter> iterators(
+                static_cast<value_t*>(::operator new(size * sizeof(value_t)))
+            );
+            destruct_n<value_t> d(0);
+            std::unique_ptr<value_t, destruct_n<value_t>&> h2(iterators.get(), d);
+
+            // Associate iterators to their position
+            difference_type count = 0;
+            for (auto ptr = iterators.get() ; first != last ; ++d, (void) ++first, ++ptr)
+            {
+                ::new(ptr) value_t(first, count++);
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Sort but takes the index into account to ensure stability
+
+            return Sorter{}(
+                make_associate_iterator(iterators.get()),
+                make_associate_iterator(iterators.get() + size),
+                make_stable_compare(std::move(compare), std::move(projection))
+            );
+        }
+
+        template<typename Sorter, typename RandomAccessIterator, typename Compare, typename Projection>
+        auto stable_sort_impl(RandomAccessIterator first, RandomAccessIterator last,
+                              Compare compare, Projection projection, std::true_type)
+            -> void
+        {
+            using rvalue_type = remove_cvref_t<rvalue_reference_t<RandomAccessIterator>>;
+
+            auto size = last - first;
+            if (static_cast<std::uint64_t>(size) > std::numeric_limits<std::uint32_t>::max()) {
+                // Positions don't fit in 32 bits, and the adapted
+                // sorter might not be able to sort with a comparison
+                std::stable_sort(std::move(first), std::move(last),
+                                 make_projection_compare(std::move(compare), std::move(projection)));
+                return;
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Pack the keys with their position
+
+            constexpr bool reverse = std::is_same<Compare, std::greater<>>::value;
+            auto&& proj = utility::as_function(projection);
+            std::unique_ptr<std::uint64_t[]> keys(new std::uint64_t[size]);
+            for (std::uint32_t pos = 0 ; pos < static_cast<std::uint32_t>(size) ; ++pos) {
+                auto key = static_cast<std::uint32_t>(total_order_key(proj(first[pos])));
+                if (reverse) {
+                    key = ~key;
+                }
+                keys[pos] = (static_cast<std::uint64_t>(key) << 32) | pos;
+            }
+            Sorter{}(keys.get(), keys.get() + size);
+
+            ////////////////////////////////////////////////////////////
+            // Move the elements to their final position
+
+            std::unique_ptr<rvalue_type, operator_deleter> buffer(
+                static_cast<rvalue_type*>(::operator new(size * sizeof(rvalue_type)))
+            );
+            destruct_n<rvalue_type> d(0);
+            std::unique_ptr<rvalue_type, destruct_n<rvalue_type>&> h2(buffer.get(), d);
+
+            auto ptr = buffer.get();
+            for (auto it = keys.get() ; it != keys.get() + size ; ++d, (void) ++it, ++ptr) {
+                using utility::iter_move;
+                ::new(ptr) rvalue_type(iter_move(first + static_cast<std::uint32_t>(*it)));
+            }
+            detail::move(buffer.get(), buffer.get() + size, std::move(first));
+        }
+
         ////////////////////////////////////////////////////////////
         // Adapter
 
@@ -121,35 +267,16 @@ namespace cppsort
             >
             auto operator()(Iterator first, Iterator last,
                             Compare compare={}, Projection projection={}) const
-                -> decltype(auto)
+                -> decltype(stable_sort_impl<Sorter>(
+                    std::move(first), std::move(last),
+                    std::move(compare), std::move(projection),
+                    can_widen_keys<Sorter, Iterator, Compare, Projection>{}
+                ))
             {
-                using difference_type = difference_type_t<Iterator>;
-                using value_t = association<Iterator, difference_type>;
-
-                ////////////////////////////////////////////////////////////
-                // Bind index to iterator
-
-                auto size = std::distance(first, last);
-                std::unique_ptr<value_t, operator_deleter> iterators(
-                    static_cast<value_t*>(::operator new(size * sizeof(value_t)))
-                );
-                destruct_n<value_t> d(0);
-                std::unique_ptr<value_t, destruct_n<value_t>&> h2(iterators.get(), d);
-
-                // Associate iterators to their position
-                difference_type count = 0;
-                for (auto ptr = iterators.get() ; first != last ; ++d, (void) ++first, ++ptr)
-                {
-                    ::new(ptr) value_t(first, count++);
-                }
-
-                ////////////////////////////////////////////////////////////
-                // Sort but takes the index into account to ensure stability
-
-                return Sorter{}(
-                    make_associate_iterator(iterators.get()),
-                    make_associate_iterator(iterators.get() + size),
-                    make_stable_compare(std::move(compare), std::move(projection))
+                return stable_sort_impl<Sorter>(
+                    std::move(first), std::move(last),
+                    std::move(compare), std::move(projection),
+                    can_widen_keys<Sorter, Iterator, Compare, Projection>{}
                 );
             }
 
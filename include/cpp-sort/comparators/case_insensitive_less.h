@@ -28,13 +28,21 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <algorithm>
+#include <cstddef>
 #include <iterator>
 #include <locale>
+#include <string>
 #include <type_traits>
 #include <utility>
 #include <cpp-sort/utility/static_const.h>
+#include "../detail/config.h"
+#include "../detail/string_keys.h"
 #include "../detail/type_traits.h"
 
+#if CPPSORT_SIMD_X86_DISPATCH && defined(__SSE2__)
+#   include <emmintrin.h>
+#endif
+
 namespace cppsort
 {
     namespace detail
@@ -42,32 +50,181 @@ namespace cppsort
         ////////////////////////////////////////////////////////////
         // Case insensitive comparison for char sequences
 
+        // Whether the facet lowercases the ASCII characters like the
+        // "C" locale does, in which case they can be folded without
+        // calling it
         template<typename CharT>
-        struct char_less
+        auto has_ascii_case_folding(const std::ctype<CharT>& ct)
+            -> bool
+        {
+            for (int c = 0 ; c < 128 ; ++c) {
+                int lower = (c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : c;
+                if (ct.tolower(static_cast<CharT>(c)) != static_cast<CharT>(lower)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        template<typename CharT>
+        struct char_fold
         {
             const std::ctype<CharT>& ct;
+            bool ascii;
+
+            auto operator()(CharT c) const
+                -> CharT
+            {
+                if (ascii && static_cast<std::make_unsigned_t<CharT>>(c) < 128u) {
+                    return (c >= 'A' && c <= 'Z') ? static_cast<CharT>(c + ('a' - 'A')) : c;
+                }
+                return ct.tolower(c);
+            }
+        };
 
-            char_less(const std::ctype<CharT>& ct):
-                ct(ct)
+        template<typename CharT>
+        struct char_less
+        {
+            char_fold<CharT> fold;
+
+            char_less(const std::ctype<CharT>& ct, bool ascii=false):
+                fold{ct, ascii}
             {}
 
             auto operator()(CharT lhs, CharT rhs) const
                 -> bool
             {
-              return ct.tolower(lhs) < ct.tolower(rhs);
+                return fold(lhs) < fold(rhs);
             }
         };
 
+        // Skip the chunks of characters that are equal once folded,
+        // stop at the first character that might not be: narrow
+        // characters are compared 16 at a time with SSE2, which is
+        // always available on x86-64
+
+#if CPPSORT_SIMD_X86_DISPATCH && defined(__SSE2__)
+        constexpr bool has_simd_case_folding = true;
+#else
+        constexpr bool has_simd_case_folding = false;
+#endif
+
+        template<typename CharT>
+        auto skip_equal_chars(const CharT*, const CharT*, std::size_t pos, std::size_t, bool)
+            -> std::enable_if_t<
+                not (has_simd_case_folding && sizeof(CharT) == 1),
+                std::size_t
+            >
+        {
+            return pos;
+        }
+
+#if CPPSORT_SIMD_X86_DISPATCH && defined(__SSE2__)
+        inline auto fold_ascii(__m128i chars)
+            -> __m128i
+        {
+            __m128i is_upper = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('A' - 1)),
+                                             _mm_cmplt_epi8(chars, _mm_set1_epi8('Z' + 1)));
+            return _mm_add_epi8(chars, _mm_and_si128(is_upper, _mm_set1_epi8('a' - 'A')));
+        }
+
+        template<typename CharT>
+        auto skip_equal_chars(const CharT* lhs, const CharT* rhs,
+                              std::size_t pos, std::size_t size, bool ascii)
+            -> std::enable_if_t<sizeof(CharT) == 1, std::size_t>
+        {
+            while (size - pos >= 16) {
+                __m128i lhs_chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs + pos));
+                __m128i rhs_chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs + pos));
+                unsigned equal = _mm_movemask_epi8(_mm_cmpeq_epi8(lhs_chars, rhs_chars));
+                if (equal != 0xFFFF) {
+                    // Fold the chunk if it only contains ASCII characters,
+                    // let the caller handle the first mismatch otherwise
+                    if (ascii && _mm_movemask_epi8(_mm_or_si128(lhs_chars, rhs_chars)) == 0) {
+                        equal = _mm_movemask_epi8(_mm_cmpeq_epi8(fold_ascii(lhs_chars),
+                                                                 fold_ascii(rhs_chars)));
+                    }
+                    if (equal != 0xFFFF) {
+                        return pos + __builtin_ctz(~equal);
+                    }
+                }
+                pos += 16;
+            }
+            return pos;
+        }
+#endif
+
+        template<typename CharT>
+        auto case_insensitive_less_chars(const CharT* lhs, std::size_t lhs_size,
+                                         const CharT* rhs, std::size_t rhs_size,
+                                         const std::ctype<CharT>& ct, bool ascii)
+            -> bool
+        {
+            char_fold<CharT> fold{ct, ascii};
+            std::size_t size = std::min(lhs_size, rhs_size);
+            for (std::size_t pos = 0 ; pos < size ; ++pos) {
+                pos = skip_equal_chars(lhs, rhs, pos, size, ascii);
+                if (pos == size) break;
+                if (lhs[pos] == rhs[pos]) continue;
+
+                CharT lhs_char = fold(lhs[pos]);
+                CharT rhs_char = fold(rhs[pos]);
+                if (lhs_char != rhs_char) {
+                    return lhs_char < rhs_char;
+                }
+            }
+            return lhs_size < rhs_size;
+        }
+
+        // Sequences storing their characters contiguously
         template<typename T>
-        auto case_insensitive_less(const T& lhs, const T& rhs, const std::locale& loc)
+        using contiguous_chars_t = std::enable_if_t<
+            std::is_pointer<decltype(std::declval<const T&>().data())>::value &&
+            std::is_same<
+                remove_cvref_t<decltype(*std::declval<const T&>().data())>,
+                remove_cvref_t<decltype(*std::begin(std::declval<const T&>()))>
+            >::value,
+            decltype(std::declval<const T&>().size())
+        >;
+
+        template<typename T, typename CharT>
+        auto case_insensitive_less_impl(const T& lhs, const T& rhs,
+                                        const std::ctype<CharT>& ct, bool ascii,
+                                        std::true_type /* contiguous */)
             -> bool
         {
-            using char_type = remove_cvref_t<decltype(*std::begin(lhs))>;
-            const auto& ct = std::use_facet<std::ctype<char_type>>(loc);
+            return case_insensitive_less_chars<CharT>(lhs.data(), lhs.size(),
+                                                      rhs.data(), rhs.size(),
+                                                      ct, ascii);
+        }
 
+        template<typename T, typename CharT>
+        auto case_insensitive_less_impl(const T& lhs, const T& rhs,
+                                        const std::ctype<CharT>& ct, bool ascii,
+                                        std::false_type /* contiguous */)
+            -> bool
+        {
             return std::lexicographical_compare(std::begin(lhs), std::end(lhs),
                                                 std::begin(rhs), std::end(rhs),
-                                                char_less<char_type>(ct));
+                                                char_less<CharT>(ct, ascii));
+        }
+
+        template<typename T, typename CharT>
+        auto case_insensitive_less_impl(const T& lhs, const T& rhs,
+                                        const std::ctype<CharT>& ct, bool ascii)
+            -> bool
+        {
+            return case_insensitive_less_impl(lhs, rhs, ct, ascii,
+                                              is_detected<contiguous_chars_t, T>{});
+        }
+
+        template<typename T>
+        auto case_insensitive_less(const T& lhs, const T& rhs, const std::locale& loc)
+            -> bool
+        {
+            using char_type = remove_cvref_t<decltype(*std::begin(lhs))>;
+            const auto& ct = std::use_facet<std::ctype<char_type>>(loc);
+            return case_insensitive_less_impl(lhs, rhs, ct, false);
         }
 
         template<typename T>
@@ -78,6 +235,77 @@ namespace cppsort
             return case_insensitive_less(lhs, rhs, loc);
         }
 
+        ////////////////////////////////////////////////////////////
+        // Case-folded keys
+
+        template<typename CharT>
+        auto case_insensitive_key(const CharT* data, std::size_t size,
+                                  const std::ctype<CharT>& ct)
+            -> std::basic_string<CharT>
+        {
+            std::basic_string<CharT> res(data, size);
+            if (size == 0) return res;
+            ct.tolower(&res[0], &res[0] + size);
+            return res;
+        }
+
+        inline auto case_insensitive_key(const char* data, std::size_t size,
+                                         const std::ctype<char>& ct)
+            -> std::string
+        {
+            std::string res(data, size);
+            if (size == 0) return res;
+            ct.tolower(&res[0], &res[0] + size);
+            for (auto& c: res) {
+                c = unsigned_order_char(c);
+            }
+            return res;
+        }
+
+        struct case_insensitive_key_locale_fn
+        {
+            private:
+
+                std::locale loc;
+
+            public:
+
+                explicit case_insensitive_key_locale_fn(const std::locale& loc):
+                    loc(loc)
+                {}
+
+                template<
+                    typename T,
+                    typename = contiguous_chars_t<T>
+                >
+                auto operator()(const T& str) const
+                    -> std::basic_string<remove_cvref_t<decltype(*str.data())>>
+                {
+                    using char_type = remove_cvref_t<decltype(*str.data())>;
+                    const auto& ct = std::use_facet<std::ctype<char_type>>(loc);
+                    return case_insensitive_key(str.data(), str.size(), ct);
+                }
+        };
+
+        struct case_insensitive_key_fn
+        {
+            template<
+                typename T,
+                typename = contiguous_chars_t<T>
+            >
+            auto operator()(const T& str) const
+                -> std::basic_string<remove_cvref_t<decltype(*str.data())>>
+            {
+                return case_insensitive_key_locale_fn(std::locale())(str);
+            }
+
+            inline auto operator()(const std::locale& loc) const
+                -> case_insensitive_key_locale_fn
+            {
+                return case_insensitive_key_locale_fn(loc);
+            }
+        };
+
         ////////////////////////////////////////////////////////////
         // Customization point
 
@@ -189,12 +417,14 @@ namespace cppsort
 
                     std::locale loc;
                     const std::ctype<char_type>& ct;
+                    bool ascii;
 
                 public:
 
                     explicit refined_case_insensitive_less_locale_fn(const std::locale& loc):
                         loc(loc),
-                        ct(std::use_facet<std::ctype<char_type>>(loc))
+                        ct(std::use_facet<std::ctype<char_type>>(loc)),
+                        ascii(has_ascii_case_folding(ct))
                     {}
 
                     template<typename U=T>
@@ -214,9 +444,7 @@ namespace cppsort
                             bool
                         >
                     {
-                        return std::lexicographical_compare(std::begin(lhs), std::end(lhs),
-                                                            std::begin(rhs), std::end(rhs),
-                                                            char_less<char_type>(ct));
+                        return case_insensitive_less_impl(lhs, rhs, ct, ascii);
                     }
             };
 
@@ -229,12 +457,14 @@ namespace cppsort
 
                     std::locale loc;
                     const std::ctype<char_type>& ct;
+                    bool ascii;
 
                 public:
 
                     refined_case_insensitive_less_fn():
                         loc(),
-                        ct(std::use_facet<std::ctype<char_type>>(loc))
+                        ct(std::use_facet<std::ctype<char_type>>(loc)),
+                        ascii(has_ascii_case_folding(ct))
                     {}
 
                     template<typename U=T>
@@ -270,9 +500,7 @@ namespace cppsort
                             bool
                         >
                     {
-                        return std::lexicographical_compare(std::begin(lhs), std::end(lhs),
-                                                            std::begin(rhs), std::end(rhs),
-                                                            char_less<char_type>(ct));
+                        return case_insensitive_less_impl(lhs, rhs, ct, ascii);
                     }
 
                     auto operator()(const std::locale& loc) const
@@ -289,6 +517,15 @@ namespace cppsort
         constexpr auto&& case_insensitive_less = utility::static_const<
             detail::case_insensitive_less_fn
         >::value;
+
+        // Projection returning a copy of a string such that the
+        // copies compare with std::less<> like the original strings
+        // compare with case_insensitive_less: computing the keys
+        // once allows radix sorters such as string_spread_sorter
+        // to sort strings case-insensitively
+        constexpr auto&& case_insensitive_key = utility::static_const<
+            detail::case_insensitive_key_fn
+        >::value;
     }
 }
 
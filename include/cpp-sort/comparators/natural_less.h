@@ -28,9 +28,15 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <cctype>
+#include <climits>
+#include <cstddef>
 #include <iterator>
+#include <string>
+#include <type_traits>
 #include <utility>
 #include <cpp-sort/utility/static_const.h>
+#include "../detail/string_keys.h"
+#include "../detail/type_traits.h"
 
 namespace cppsort
 {
@@ -39,6 +45,16 @@ namespace cppsort
         ////////////////////////////////////////////////////////////
         // Natural order for char sequences
 
+        // std::isdigit only accepts values representable as unsigned
+        // char, which negative chars and wider code units aren't
+        template<typename CharT>
+        auto is_digit(CharT c)
+            -> bool
+        {
+            auto value = static_cast<std::make_unsigned_t<CharT>>(c);
+            return value <= UCHAR_MAX && std::isdigit(static_cast<unsigned char>(value));
+        }
+
         template<typename ForwardIterator>
         auto natural_less_impl(ForwardIterator begin1, ForwardIterator end1,
                                ForwardIterator begin2, ForwardIterator end2)
@@ -48,11 +64,11 @@ namespace cppsort
                 auto last1 = begin1;
                 auto last2 = begin2;
                 do {
-                    if (not std::isdigit(*last1)) break;
+                    if (not is_digit(*last1)) break;
                     ++last1;
                 } while (last1 != end1);
                 do {
-                    if (not std::isdigit(*last2)) break;
+                    if (not is_digit(*last2)) break;
                     ++last2;
                 } while (last2 != end2);
 
@@ -73,12 +89,9 @@ namespace cppsort
                     if (size1 != size2) {
                         return size1 < size2;
                     }
-                    if (size1 == 0) {
-                        return false;
-                    }
 
-                    // Sizes are equal and not 0
-                    while (begin1 != end1) {
+                    // Sizes are equal, compare the digits
+                    while (begin1 != last1) {
                         if (*begin1 != *begin2) {
                             return *begin1 < *begin2;
                         }
@@ -113,6 +126,64 @@ namespace cppsort
                                      std::begin(rhs), std::end(rhs));
         }
 
+        ////////////////////////////////////////////////////////////
+        // Natural order keys
+        //
+        // Characters go through unsigned_order_char, except for the
+        // digit sequences: they become a marker in the range of
+        // digits, followed by the size of the number without its
+        // leading zeros and by its significant digits. The marker
+        // compares to the other characters like any digit would, and
+        // two numbers compare by size first, then by digits. Sizes of
+        // 255 and above are written as a sequence of 255 followed by
+        // the remainder.
+
+        template<typename CharT, typename ForwardIterator>
+        auto natural_key(ForwardIterator first, ForwardIterator last)
+            -> std::basic_string<CharT>
+        {
+            std::basic_string<CharT> res;
+            while (first != last) {
+                if (not is_digit(*first)) {
+                    res.push_back(unsigned_order_char(static_cast<CharT>(*first)));
+                    ++first;
+                    continue;
+                }
+
+                // Skip leading zeros
+                while (first != last && *first == '0') {
+                    ++first;
+                }
+                auto digits_first = first;
+                std::size_t size = 0;
+                while (first != last && is_digit(*first)) {
+                    ++first;
+                    ++size;
+                }
+
+                res.push_back(unsigned_order_char(static_cast<CharT>('0')));
+                for (; size >= 255 ; size -= 255) {
+                    res.push_back(static_cast<CharT>(255));
+                }
+                res.push_back(static_cast<CharT>(size));
+                for (; digits_first != first ; ++digits_first) {
+                    res.push_back(unsigned_order_char(static_cast<CharT>(*digits_first)));
+                }
+            }
+            return res;
+        }
+
+        struct natural_key_fn
+        {
+            template<typename T>
+            auto operator()(const T& value) const
+                -> std::basic_string<remove_cvref_t<decltype(*std::begin(value))>>
+            {
+                using char_type = remove_cvref_t<decltype(*std::begin(value))>;
+                return natural_key<char_type>(std::begin(value), std::end(value));
+            }
+        };
+
         ////////////////////////////////////////////////////////////
         // Customization point
 
@@ -133,6 +204,14 @@ namespace cppsort
         constexpr auto&& natural_less = utility::static_const<
             detail::natural_less_fn
         >::value;
+
+        // Projection returning a key such that the keys compare with
+        // std::less<> like the original sequences compare with
+        // natural_less: computing the keys once allows radix sorters
+        // such as string_spread_sorter to sort strings naturally
+        constexpr auto&& natural_key = utility::static_const<
+            detail::natural_key_fn
+        >::value;
     }
 }
 
@@ -33,6 +33,7 @@
 #include <cpp-sort/utility/branchless_traits.h>
 #include <cpp-sort/utility/static_const.h>
 #include "../detail/floating_point_weight.h"
+#include "../detail/total_order_key.h"
 
 namespace cppsort
 {
@@ -53,7 +54,21 @@ namespace cppsort
 
         template<typename T>
         auto total_less(T lhs, T rhs)
-            -> std::enable_if_t<std::is_floating_point<T>::value, bool>
+            -> std::enable_if_t<
+                std::is_floating_point<T>::value && has_total_order_key<T>::value,
+                bool
+            >
+        {
+            // Also orders NaNs by sign, kind and payload
+            return total_order_key(lhs) < total_order_key(rhs);
+        }
+
+        template<typename T>
+        auto total_less(T lhs, T rhs)
+            -> std::enable_if_t<
+                std::is_floating_point<T>::value && not has_total_order_key<T>::value,
+                bool
+            >
         {
             if (std::isfinite(lhs) && std::isfinite(rhs)) {
                 if (lhs == 0 && rhs == 0) {
@@ -0,0 +1,141 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_DETAIL_BRANCHLESS_MERGE_H_
+#define CPPSORT_DETAIL_BRANCHLESS_MERGE_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/branchless_traits.h>
+#include "iterator_traits.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // Whether the branchless merge can be used: the elements
+    // have to be cheap to copy and the comparison should not
+    // introduce branches itself
+
+    template<typename Iterator, typename Compare, typename Projection>
+    using can_merge_branchless = std::integral_constant<
+        bool,
+        utility::is_probably_branchless_comparison_v<Compare, projected_t<Iterator, Projection>> &&
+        utility::is_probably_branchless_projection_v<Projection, value_type_t<Iterator>> &&
+        std::is_trivially_copyable<value_type_t<Iterator>>::value &&
+        std::is_lvalue_reference<reference_t<Iterator>>::value
+    >;
+
+    ////////////////////////////////////////////////////////////
+    // Merge the sorted ranges [first1, first1 + len1) and
+    // [first2, first2 + len2) into the range starting at result,
+    // which must not overlap with either input range
+    //
+    // The algorithm merges the smallest elements from the front
+    // and the biggest elements from the back in the same loop:
+    // both merges are independent, which halves the length of
+    // the dependency chain, and the cursors are advanced with
+    // conditional moves instead of branches. Each round stops
+    // after min(len1, len2) steps from each end so that no
+    // cursor can read past its run; the remaining elements are
+    // merged again the same way
+
+    template<typename BidirectionalIterator1, typename BidirectionalIterator2,
+             typename BidirectionalIterator3, typename Compare, typename Projection>
+    auto parity_merge(BidirectionalIterator1 first1,
+                      difference_type_t<BidirectionalIterator1> len1,
+                      BidirectionalIterator2 first2,
+                      difference_type_t<BidirectionalIterator2> len2,
+                      BidirectionalIterator3 result,
+                      Compare compare, Projection projection)
+        -> void
+    {
+        auto&& comp = utility::as_function(compare);
+        auto&& proj = utility::as_function(projection);
+
+        auto last1 = std::next(first1, len1);
+        auto last2 = std::next(first2, len2);
+        auto result_last = std::next(result, len1 + len2);
+
+        while (len1 > 0 && len2 > 0) {
+            for (auto count = std::min(len1, len2) ; count > 0 ; --count) {
+                // Ties are resolved in favour of the first run from
+                // the front and of the second run from the back
+                auto front1 = *first1;
+                auto front2 = *first2;
+                bool take_second = comp(proj(front2), proj(front1));
+                *result = take_second ? front2 : front1;
+                ++result;
+                std::advance(first2, difference_type_t<BidirectionalIterator2>(take_second));
+                std::advance(first1, difference_type_t<BidirectionalIterator1>(not take_second));
+
+                auto back1 = *std::prev(last1);
+                auto back2 = *std::prev(last2);
+                bool take_first = comp(proj(back2), proj(back1));
+                --result_last;
+                *result_last = take_first ? back1 : back2;
+                std::advance(last1, -difference_type_t<BidirectionalIterator1>(take_first));
+                std::advance(last2, -difference_type_t<BidirectionalIterator2>(not take_first));
+            }
+            len1 = std::distance(first1, last1);
+            len2 = std::distance(first2, last2);
+        }
+
+        // At most one of the runs still has elements
+        result = std::copy(first1, last1, result);
+        std::copy(first2, last2, result);
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Merge two consecutive sorted ranges of sizes len1 and
+    // len2 starting at first, the buffer must be able to hold
+    // len1 + len2 elements
+
+    template<typename BidirectionalIterator, typename T,
+             typename Compare, typename Projection>
+    auto branchless_merge(BidirectionalIterator first, BidirectionalIterator last,
+                          difference_type_t<BidirectionalIterator> len1,
+                          difference_type_t<BidirectionalIterator> len2,
+                          T* buffer, Compare compare, Projection projection)
+        -> void
+    {
+        // Copy both runs to the buffer, the elements are
+        // trivially copyable so they don't need to be destroyed
+        T* ptr = buffer;
+        for (auto it = first ; it != last ; ++it, (void) ++ptr) {
+            ::new(ptr) T(*it);
+        }
+
+        parity_merge(buffer, len1, buffer + len1, len2, std::move(first),
+                     std::move(compare), std::move(projection));
+    }
+}}
+
+#endif // CPPSORT_DETAIL_BRANCHLESS_MERGE_H_
@@ -80,4 +80,21 @@
 #   define CPPSORT_UNREACHABLE
 #endif
 
+////////////////////////////////////////////////////////////
+// CPPSORT_SIMD_X86_DISPATCH
+
+// Some algorithms have SIMD kernels which are selected at
+// runtime depending on the features of the CPU; they rely
+// on the target attribute and on __builtin_cpu_supports, so
+// they are only available with GCC and Clang on x86, and can
+// be disabled altogether by defining CPPSORT_DISABLE_SIMD
+
+#if !defined(CPPSORT_DISABLE_SIMD) && \
+    (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#   define CPPSORT_SIMD_X86_DISPATCH 1
+#else
+#   define CPPSORT_SIMD_X86_DISPATCH 0
+#endif
+
 #endif // CPPSORT_DETAIL_CONFIG_H_
@@ -450,7 +450,8 @@ namespace detail
         -> void
     {
         auto&& proj = utility::as_function(projection);
-        auto&& midkey_proj = proj(*midkey);
+        decltype(auto) midkey_value = *midkey;
+        auto&& midkey_proj = proj(midkey_value);
 
         if (nblock == 0) {
             RandomAccessIterator l = arr + nblock2 * lblock;
@@ -45,6 +45,7 @@
 #include "lower_bound.h"
 #include "memory.h"
 #include "rotate.h"
+#include "simd_merge.h"
 #include "type_traits.h"
 #include "upper_bound.h"
 
@@ -507,6 +508,16 @@ namespace detail
 
         auto len1 = std::distance(first, middle);
         auto len2 = std::distance(middle, last);
+
+        if (is_simd_merge_available<BidirectionalIterator, Compare, Projection>()) {
+            temporary_buffer<rvalue_reference> buffer(len1);
+            if (buffer.size() >= len1) {
+                simd_inplace_merge(std::move(first), std::move(middle), std::move(last),
+                                   buffer.data(), std::move(compare), std::move(projection));
+                return;
+            }
+        }
+
         temporary_buffer<rvalue_reference> buffer(std::min(len1, len2));
 
         using category = iterator_category_t<BidirectionalIterator>;
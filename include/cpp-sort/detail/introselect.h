@@ -28,6 +28,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <iterator>
+#include <type_traits>
 #include <utility>
 #include <cpp-sort/utility/as_function.h>
 #include <cpp-sort/utility/iter_move.h>
@@ -39,6 +40,7 @@
 #include "iterator_traits.h"
 #include "partition.h"
 #include "swap_if.h"
+#include "three_way_compare.h"
 
 namespace cppsort
 {
@@ -278,6 +280,114 @@ namespace detail
         }
     }
 
+    ////////////////////////////////////////////////////////////
+    // Partition [first, last) around the pivot in last_1 into
+    // [< pivot][== pivot][> pivot], returns the bounds of the
+    // middle partition
+
+    template<typename ForwardIterator, typename Compare, typename Projection>
+    auto pivot_partition(ForwardIterator first, ForwardIterator last_1, ForwardIterator last,
+                         Compare compare, Projection projection,
+                         std::false_type /* three-way comparison */)
+        -> std::pair<ForwardIterator, ForwardIterator>
+    {
+        using utility::iter_swap;
+
+        auto&& comp = utility::as_function(compare);
+        auto&& proj = utility::as_function(projection);
+
+        // Partition the elements before the pivot
+        decltype(auto) pivot1_value = *last_1;
+        auto&& pivot1 = proj(pivot1_value);
+        ForwardIterator middle1 = detail::partition(
+            first, last_1,
+            [&](const auto& elem) { return comp(proj(elem), pivot1); }
+        );
+
+        // Put the pivot in its final position and partition
+        iter_swap(middle1, last_1);
+        decltype(auto) pivot2_value = *middle1;
+        auto&& pivot2 = proj(pivot2_value);
+        ForwardIterator middle2 = detail::partition(
+            std::next(middle1), last,
+            [&](const auto& elem) { return not comp(pivot2, proj(elem)); }
+        );
+
+        return { middle1, middle2 };
+    }
+
+    template<typename ForwardIterator, typename Compare, typename Projection>
+    auto pivot_partition(ForwardIterator first, ForwardIterator last_1, ForwardIterator,
+                         Compare compare, Projection projection,
+                         std::true_type /* three-way comparison */)
+        -> std::pair<ForwardIterator, ForwardIterator>
+    {
+        using utility::iter_move;
+        using utility::iter_swap;
+        using compare_t = std::remove_reference_t<decltype(utility::as_function(compare))>;
+        three_way_compare<compare_t> comp(utility::as_function(compare));
+        auto&& proj = utility::as_function(projection);
+
+        // Single pass where every element is compared once to the
+        // pivot, [first, middle1) holds the elements smaller than
+        // the pivot, [middle1, middle2) the equivalent ones and
+        // [middle2, it) the greater ones
+        decltype(auto) pivot_value = *last_1;
+        auto&& pivot = proj(pivot_value);
+        ForwardIterator middle1 = first;
+        ForwardIterator middle2 = first;
+        for (auto it = first ; it != last_1 ; ++it) {
+            int res = comp(proj(*it), pivot);
+            if (res < 0) {
+                if (middle1 == middle2) {
+                    if (it != middle1) {
+                        iter_swap(it, middle1);
+                    }
+                } else if (it == middle2) {
+                    // No greater element yet, the first equivalent
+                    // element goes to the end of its partition
+                    iter_swap(middle1, it);
+                } else {
+                    // Rotate the three elements with a single
+                    // temporary instead of two swaps
+                    auto tmp = iter_move(it);
+                    *it = iter_move(middle2);
+                    *middle2 = iter_move(middle1);
+                    *middle1 = std::move(tmp);
+                }
+                ++middle1;
+                ++middle2;
+            } else if (res == 0) {
+                if (it != middle2) {
+                    iter_swap(it, middle2);
+                }
+                ++middle2;
+            }
+        }
+
+        // Put the pivot in the middle partition
+        if (middle2 != last_1) {
+            iter_swap(middle2, last_1);
+        }
+        ++middle2;
+        return { middle1, middle2 };
+    }
+
+    template<typename ForwardIterator, typename Compare, typename Projection>
+    auto pivot_partition(ForwardIterator first, ForwardIterator last_1, ForwardIterator last,
+                         Compare compare, Projection projection)
+        -> std::pair<ForwardIterator, ForwardIterator>
+    {
+        using compare_t = std::remove_reference_t<decltype(utility::as_function(compare))>;
+        using has_three_way = has_three_way_comparison<
+            compare_t,
+            projected_t<ForwardIterator, Projection>
+        >;
+        return pivot_partition(std::move(first), std::move(last_1), std::move(last),
+                               std::move(compare), std::move(projection),
+                               has_three_way{});
+    }
+
     ////////////////////////////////////////////////////////////
     // Forward nth_element based on introselect
 
@@ -290,9 +400,6 @@ namespace detail
     {
         using utility::iter_swap;
 
-        auto&& comp = utility::as_function(compare);
-        auto&& proj = utility::as_function(projection);
-
         if (size <= 32) {
             small_sort(first, last, size, std::move(compare), std::move(projection));
             return std::next(first, nth_pos);
@@ -305,19 +412,9 @@ namespace detail
 
         // Put the pivot at position std::prev(last) and partition
         iter_swap(median_it, last_1);
-        auto&& pivot1 = proj(*last_1);
-        auto middle1 = detail::partition(
-            first, last_1,
-            [&](const auto& elem) { return comp(proj(elem), pivot1); }
-        );
-
-        // Put the pivot in its final position and partition
-        iter_swap(middle1, last_1);
-        auto&& pivot2 = proj(*middle1);
-        auto middle2 = detail::partition(
-            std::next(middle1), last,
-            [&](const auto& elem) { return not comp(pivot2, proj(elem)); }
-        );
+        auto middles = pivot_partition(first, last_1, last, compare, projection);
+        auto middle1 = middles.first;
+        auto middle2 = middles.second;
 
         // Recursive call: heuristic trick here: in real world cases,
         // the middle partition is more likely to be smaller than the
@@ -0,0 +1,803 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_DETAIL_IPS4O_H_
+#define CPPSORT_DETAIL_IPS4O_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <random>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/iter_move.h>
+#include "bitops.h"
+#include "iterator_traits.h"
+#include "memory.h"
+#include "pdqsort.h"
+#include "type_traits.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    namespace ips4o_detail {
+
+        ////////////////////////////////////////////////////////////
+        // Tuning parameters
+
+        // Default maximum number of buckets of the search tree,
+        // equality buckets not included
+        constexpr int log_max_buckets = 8;
+
+        // Ranges smaller than this are sorted with pdqsort
+        constexpr std::ptrdiff_t base_case_size = 4096;
+
+        // Ranges smaller than this are always sorted sequentially
+        constexpr std::ptrdiff_t parallel_threshold = std::ptrdiff_t(1) << 16;
+
+        // Number of elements classified together
+        constexpr int classify_unroll = 8;
+
+        // Elements are moved around in blocks of about 2KiB
+        template<typename T>
+        constexpr auto block_size() noexcept
+            -> std::ptrdiff_t
+        {
+            return sizeof(T) >= 2048 ? 1 : 2048 / sizeof(T);
+        }
+
+        constexpr auto align_up(std::ptrdiff_t value, std::ptrdiff_t alignment) noexcept
+            -> std::ptrdiff_t
+        {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Uninitialized storage for blocks of elements
+
+        template<typename T>
+        using raw_buffer = std::unique_ptr<T, operator_deleter>;
+
+        template<typename T>
+        auto make_raw_buffer(std::ptrdiff_t size)
+            -> raw_buffer<T>
+        {
+            return raw_buffer<T>(static_cast<T*>(::operator new(size * sizeof(T))));
+        }
+
+        // Move a block of elements to uninitialized storage
+        template<typename RandomAccessIterator, typename T>
+        auto read_block(RandomAccessIterator first, std::ptrdiff_t size, T* block)
+            -> void
+        {
+            using utility::iter_move;
+            for (std::ptrdiff_t i = 0 ; i < size ; ++i) {
+                ::new(block + i) T(iter_move(first + i));
+            }
+        }
+
+        // Move a block of elements out of storage, destroying
+        // the moved-from elements
+        template<typename T, typename RandomAccessIterator>
+        auto write_block(T* block, std::ptrdiff_t size, RandomAccessIterator first)
+            -> void
+        {
+            for (std::ptrdiff_t i = 0 ; i < size ; ++i) {
+                *(first + i) = std::move(block[i]);
+                block[i].~T();
+            }
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Branchless classifier: copies of the projected splitters
+        // are stored as an implicit binary search tree, and the search descends one
+        // level at a time for several elements at once so that the
+        // comparisons of independent elements can overlap
+        //
+        // Bucket b receives the elements greater than splitter b-1
+        // and not greater than splitter b; when the sample contains
+        // duplicate splitters, every splitter additionally gets its
+        // own equality bucket, so that ranges with many equivalent
+        // elements don't need to be recursed into
+
+        template<typename Key, typename Compare, typename Projection>
+        class classifier
+        {
+            public:
+
+                classifier(Compare compare, Projection projection):
+                    compare_(std::move(compare)),
+                    projection_(std::move(projection))
+                {}
+
+                // Pick equidistant splitters from a sorted sample
+                template<typename RandomAccessIterator>
+                auto build(RandomAccessIterator sample, std::ptrdiff_t sample_size,
+                           int log_buckets)
+                    -> void
+                {
+                    auto&& comp = utility::as_function(compare_);
+                    auto&& proj = utility::as_function(projection_);
+
+                    std::ptrdiff_t max_splitters = (std::ptrdiff_t(1) << log_buckets) - 1;
+                    std::ptrdiff_t step = sample_size / (max_splitters + 1);
+
+                    splitters_.clear();
+                    splitters_.reserve(max_splitters + 1);
+                    use_equal_buckets_ = false;
+                    for (std::ptrdiff_t i = 1 ; i <= max_splitters ; ++i) {
+                        auto it = sample + (i * step - 1);
+                        if (not splitters_.empty() && not comp(splitters_.back(), proj(*it))) {
+                            use_equal_buckets_ = true;
+                            continue;
+                        }
+                        splitters_.emplace_back(proj(*it));
+                    }
+
+                    // Pad the splitters to a power of 2 minus 1, then
+                    // add a sentinel used by the equality check
+                    log_buckets_ = static_cast<int>(detail::log2(splitters_.size())) + 1;
+                    num_tree_buckets_ = std::ptrdiff_t(1) << log_buckets_;
+                    while (static_cast<std::ptrdiff_t>(splitters_.size()) < num_tree_buckets_) {
+                        splitters_.push_back(splitters_.back());
+                    }
+
+                    tree_.assign(num_tree_buckets_, splitters_.front());
+                    std::ptrdiff_t index = 0;
+                    build_tree(1, index);
+                }
+
+                auto num_buckets() const noexcept
+                    -> std::ptrdiff_t
+                {
+                    return use_equal_buckets_ ? 2 * num_tree_buckets_ : num_tree_buckets_;
+                }
+
+                auto is_equal_bucket(std::ptrdiff_t bucket) const noexcept
+                    -> bool
+                {
+                    return use_equal_buckets_ && bucket % 2 == 1 && bucket != num_buckets() - 1;
+                }
+
+                template<typename U>
+                auto classify(const U& value)
+                    -> std::ptrdiff_t
+                {
+                    auto&& comp = utility::as_function(compare_);
+                    auto&& proj = utility::as_function(projection_);
+
+                    std::ptrdiff_t bucket = 1;
+                    for (int level = 0 ; level < log_buckets_ ; ++level) {
+                        bucket = 2 * bucket + comp(tree_[bucket], proj(value));
+                    }
+                    bucket -= num_tree_buckets_;
+                    if (use_equal_buckets_) {
+                        bucket = 2 * bucket + not comp(proj(value), splitters_[bucket]);
+                    }
+                    return bucket;
+                }
+
+                // Call yield(bucket, it) for every iterator of the range
+                template<typename RandomAccessIterator, typename Yield>
+                auto classify_range(RandomAccessIterator first, RandomAccessIterator last,
+                                    Yield yield)
+                    -> void
+                {
+                    auto&& comp = utility::as_function(compare_);
+                    auto&& proj = utility::as_function(projection_);
+
+                    // Local copies help the compiler keep them in registers
+                    const Key* tree = tree_.data();
+                    const Key* splitters = splitters_.data();
+                    const int log_buckets = log_buckets_;
+                    const std::ptrdiff_t num_tree_buckets = num_tree_buckets_;
+
+                    for (; last - first >= classify_unroll ; first += classify_unroll) {
+                        // Unrolled by hand, compilers don't always keep
+                        // the indices in registers otherwise
+                        std::ptrdiff_t b0 = 1, b1 = 1, b2 = 1, b3 = 1,
+                                       b4 = 1, b5 = 1, b6 = 1, b7 = 1;
+                        for (int level = 0 ; level < log_buckets ; ++level) {
+                            b0 = 2 * b0 + comp(tree[b0], proj(first[0]));
+                            b1 = 2 * b1 + comp(tree[b1], proj(first[1]));
+                            b2 = 2 * b2 + comp(tree[b2], proj(first[2]));
+                            b3 = 2 * b3 + comp(tree[b3], proj(first[3]));
+                            b4 = 2 * b4 + comp(tree[b4], proj(first[4]));
+                            b5 = 2 * b5 + comp(tree[b5], proj(first[5]));
+                            b6 = 2 * b6 + comp(tree[b6], proj(first[6]));
+                            b7 = 2 * b7 + comp(tree[b7], proj(first[7]));
+                        }
+                        std::ptrdiff_t buckets[classify_unroll] = {
+                            b0 - num_tree_buckets, b1 - num_tree_buckets,
+                            b2 - num_tree_buckets, b3 - num_tree_buckets,
+                            b4 - num_tree_buckets, b5 - num_tree_buckets,
+                            b6 - num_tree_buckets, b7 - num_tree_buckets
+                        };
+                        if (use_equal_buckets_) {
+                            for (int i = 0 ; i < classify_unroll ; ++i) {
+                                buckets[i] = 2 * buckets[i]
+                                           + not comp(proj(first[i]), splitters[buckets[i]]);
+                            }
+                        }
+                        for (int i = 0 ; i < classify_unroll ; ++i) {
+                            yield(buckets[i], first + i);
+                        }
+                    }
+
+                    for (; first != last ; ++first) {
+                        yield(classify(*first), first);
+                    }
+                }
+
+            private:
+
+                // Fill the tree in-order with the sorted splitters
+                auto build_tree(std::ptrdiff_t node, std::ptrdiff_t& index)
+                    -> void
+                {
+                    if (node >= num_tree_buckets_) return;
+                    build_tree(2 * node, index);
+                    tree_[node] = splitters_[index++];
+                    build_tree(2 * node + 1, index);
+                }
+
+                Compare compare_;
+                Projection projection_;
+                std::vector<Key> tree_;
+                std::vector<Key> splitters_;
+                std::ptrdiff_t num_tree_buckets_ = 0;
+                int log_buckets_ = 0;
+                bool use_equal_buckets_ = false;
+        };
+
+        ////////////////////////////////////////////////////////////
+        // Per-thread buffers: one block per bucket to gather the
+        // classified elements, and two blocks to swap blocks
+        // during the permutation
+
+        template<typename T>
+        struct local_data
+        {
+            local_data(std::ptrdiff_t max_buckets, std::ptrdiff_t block):
+                buffers(make_raw_buffer<T>(max_buckets * block)),
+                swap(make_raw_buffer<T>(2 * block)),
+                fill(max_buckets),
+                counts(max_buckets)
+            {}
+
+            raw_buffer<T> buffers;
+            raw_buffer<T> swap;
+            // Number of elements in the buffer of each bucket
+            std::vector<std::ptrdiff_t> fill;
+            // Number of elements of the stripe in each bucket
+            std::vector<std::ptrdiff_t> counts;
+            // End of the full blocks written back to the stripe
+            std::ptrdiff_t write_end = 0;
+        };
+
+        ////////////////////////////////////////////////////////////
+        // Block pointers of a bucket during the permutation: the
+        // blocks in [write, read_end) are not processed yet
+
+        struct null_mutex
+        {
+            auto lock() noexcept -> void {}
+            auto unlock() noexcept -> void {}
+        };
+
+        template<typename Mutex>
+        struct bucket_pointers
+        {
+            Mutex mutex;
+            std::ptrdiff_t write = 0;
+            std::ptrdiff_t read_end = 0;
+        };
+
+        ////////////////////////////////////////////////////////////
+        // Run function(id) on num_threads threads, including the
+        // current one, and rethrow the first exception thrown
+
+        template<typename Function>
+        auto run_in_parallel(int num_threads, Function function)
+            -> void
+        {
+            if (num_threads <= 1) {
+                function(0);
+                return;
+            }
+
+            std::exception_ptr error = nullptr;
+            std::mutex error_mutex;
+            auto task = [&](int id) {
+                try {
+                    function(id);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(error_mutex);
+                    if (not error) {
+                        error = std::current_exception();
+                    }
+                }
+            };
+
+            std::vector<std::thread> threads;
+            threads.reserve(num_threads - 1);
+            try {
+                for (int id = 1 ; id < num_threads ; ++id) {
+                    threads.emplace_back(task, id);
+                }
+            } catch (...) {
+                for (auto& thread: threads) {
+                    thread.join();
+                }
+                throw;
+            }
+            task(0);
+            for (auto& thread: threads) {
+                thread.join();
+            }
+
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Partition [first, last) into buckets in-place, returns
+        // the boundaries of the buckets and the classifier
+
+        template<typename Key, typename Compare, typename Projection>
+        struct partition_result
+        {
+            std::vector<std::ptrdiff_t> bounds;
+            classifier<Key, Compare, Projection> classify;
+        };
+
+        template<typename T>
+        auto log_buckets_for(std::ptrdiff_t size, int log_max)
+            -> int
+        {
+            auto blocks = std::max<std::ptrdiff_t>(1, size / (4 * block_size<T>()));
+            return std::max(1, std::min(log_max, static_cast<int>(detail::log2(blocks))));
+        }
+
+        template<typename Mutex, typename RandomAccessIterator, typename T,
+                 typename Compare, typename Projection>
+        auto partition(RandomAccessIterator first, RandomAccessIterator last,
+                       Compare compare, Projection projection,
+                       local_data<T>* locals, int num_threads, int log_max)
+            -> partition_result<projected_t<RandomAccessIterator, Projection>, Compare, Projection>
+        {
+            using key_type = projected_t<RandomAccessIterator, Projection>;
+            using utility::iter_move;
+            using utility::iter_swap;
+
+            std::ptrdiff_t size = last - first;
+            constexpr std::ptrdiff_t block = block_size<T>();
+
+            ////////////////////////////////////////////////////////////
+            // Sampling: move a random sample to the front of the
+            // range, sort it and pick the splitters
+
+            int log_buckets = log_buckets_for<T>(size, log_max);
+            std::ptrdiff_t oversampling = std::max<std::ptrdiff_t>(1, detail::log2(size) / 5);
+            std::ptrdiff_t sample_size = std::min(size / 2,
+                                                  oversampling << log_buckets);
+
+            std::minstd_rand engine(static_cast<std::minstd_rand::result_type>(size));
+            for (std::ptrdiff_t i = 0 ; i < sample_size ; ++i) {
+                std::uniform_int_distribution<std::ptrdiff_t> dist(i, size - 1);
+                iter_swap(first + i, first + dist(engine));
+            }
+            pdqsort(first, first + sample_size, compare, projection);
+
+            partition_result<key_type, Compare, Projection> result = {
+                {},
+                classifier<key_type, Compare, Projection>(compare, projection)
+            };
+            auto& tree = result.classify;
+            tree.build(first, sample_size, log_buckets);
+            std::ptrdiff_t num_buckets = tree.num_buckets();
+
+            ////////////////////////////////////////////////////////////
+            // Local classification: every thread classifies its
+            // stripe and writes the full blocks of its buffers back
+            // to the beginning of the stripe
+
+            std::ptrdiff_t stripe = align_up((size + num_threads - 1) / num_threads, block);
+            run_in_parallel(num_threads, [&](int id) {
+                auto& local = locals[id];
+                std::fill_n(local.fill.begin(), num_buckets, 0);
+                std::fill_n(local.counts.begin(), num_buckets, 0);
+
+                std::ptrdiff_t begin = std::min(size, id * stripe);
+                std::ptrdiff_t end = std::min(size, begin + stripe);
+                std::ptrdiff_t write = begin;
+                T* buffers = local.buffers.get();
+                std::ptrdiff_t* fill = local.fill.data();
+                std::ptrdiff_t* counts = local.counts.data();
+                tree.classify_range(first + begin, first + end, [&](std::ptrdiff_t bucket, RandomAccessIterator it) {
+                    T* buffer = buffers + bucket * block;
+                    ::new(buffer + fill[bucket]) T(iter_move(it));
+                    if (++fill[bucket] == block) {
+                        // The elements up to it have already been read
+                        write_block(buffer, block, first + write);
+                        write += block;
+                        fill[bucket] = 0;
+                        counts[bucket] += block;
+                    }
+                });
+                for (std::ptrdiff_t bucket = 0 ; bucket < num_buckets ; ++bucket) {
+                    counts[bucket] += fill[bucket];
+                }
+                local.write_end = write;
+            });
+
+            auto& bounds = result.bounds;
+            bounds.assign(num_buckets + 1, 0);
+            for (std::ptrdiff_t bucket = 0 ; bucket < num_buckets ; ++bucket) {
+                bounds[bucket + 1] = bounds[bucket];
+                for (int id = 0 ; id < num_threads ; ++id) {
+                    bounds[bucket + 1] += locals[id].counts[bucket];
+                }
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Move the full blocks of every bucket area to the front
+            // of the area: the gaps left at the end of the stripes
+            // are smaller than the buffers, so few blocks move
+
+            auto is_full = [&](std::ptrdiff_t pos) {
+                return pos < size && pos < locals[pos / stripe].write_end;
+            };
+
+            std::vector<bucket_pointers<Mutex>> pointers(num_buckets);
+            for (std::ptrdiff_t bucket = 0 ; bucket < num_buckets ; ++bucket) {
+                std::ptrdiff_t left = align_up(bounds[bucket], block);
+                std::ptrdiff_t right = align_up(bounds[bucket + 1], block);
+                pointers[bucket].write = left;
+                while (true) {
+                    while (left < right && is_full(left)) {
+                        left += block;
+                    }
+                    while (left < right && not is_full(right - block)) {
+                        right -= block;
+                    }
+                    if (left >= right) break;
+                    right -= block;
+                    for (std::ptrdiff_t i = 0 ; i < block ; ++i) {
+                        *(first + (left + i)) = iter_move(first + (right + i));
+                    }
+                    left += block;
+                }
+                pointers[bucket].read_end = left;
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Block permutation: every thread takes unprocessed blocks
+            // and swaps them into the next free slot of their bucket
+            // until it finds an empty slot
+
+            // The block straddling the end of the range, if any, is
+            // written to a separate buffer and handled in the cleanup
+            auto overflow = make_raw_buffer<T>(block);
+            std::ptrdiff_t overflow_bucket = -1;
+
+            run_in_parallel(num_threads, [&](int id) {
+                T* swap[2] = { locals[id].swap.get(), locals[id].swap.get() + block };
+                for (std::ptrdiff_t i = 0 ; i < num_buckets ; ++i) {
+                    auto& source = pointers[(id * num_buckets / num_threads + i) % num_buckets];
+                    while (true) {
+                        {
+                            std::lock_guard<Mutex> lock(source.mutex);
+                            if (source.write >= source.read_end) break;
+                            source.read_end -= block;
+                            read_block(first + source.read_end, block, swap[0]);
+                        }
+
+                        int current = 0;
+                        while (true) {
+                            auto target = tree.classify(*swap[current]);
+                            auto& dest = pointers[target];
+                            std::lock_guard<Mutex> lock(dest.mutex);
+                            std::ptrdiff_t pos = dest.write;
+                            dest.write += block;
+                            if (pos < dest.read_end) {
+                                read_block(first + pos, block, swap[1 - current]);
+                                write_block(swap[current], block, first + pos);
+                                current = 1 - current;
+                            } else {
+                                if (pos + block > size) {
+                                    for (std::ptrdiff_t j = 0 ; j < block ; ++j) {
+                                        ::new(overflow.get() + j) T(std::move(swap[current][j]));
+                                        swap[current][j].~T();
+                                    }
+                                    overflow_bucket = target;
+                                } else {
+                                    write_block(swap[current], block, first + pos);
+                                }
+                                break;
+                            }
+                        }
+                    }
+                }
+            });
+
+            ////////////////////////////////////////////////////////////
+            // Cleanup: move the elements that belong to every bucket
+            // but lie outside of it, those left in the buffers and in
+            // the overflow block to the free slots of the bucket; the
+            // buckets are processed in order so that the elements of
+            // a bucket spilling over the next one are moved before
+            // the next bucket fills its own slots
+
+            for (std::ptrdiff_t bucket = 0 ; bucket < num_buckets ; ++bucket) {
+                std::ptrdiff_t begin = bounds[bucket];
+                std::ptrdiff_t end = bounds[bucket + 1];
+                std::ptrdiff_t aligned_begin = align_up(begin, block);
+                std::ptrdiff_t full_end = pointers[bucket].write;
+                if (bucket == overflow_bucket) {
+                    full_end -= block;
+                }
+
+                // Free slots: [begin, aligned_begin) then [full_end, end)
+                std::ptrdiff_t head_end = std::min(aligned_begin, end);
+                std::ptrdiff_t tail_begin = std::max(full_end, aligned_begin);
+                std::ptrdiff_t pos = begin;
+                auto put = [&](auto&& value) {
+                    if (pos == head_end) {
+                        pos = tail_begin;
+                    }
+                    *(first + pos) = std::move(value);
+                    ++pos;
+                };
+
+                for (auto i = std::max(end, aligned_begin) ; i < full_end ; ++i) {
+                    put(iter_move(first + i));
+                }
+                for (int id = 0 ; id < num_threads ; ++id) {
+                    T* buffer = locals[id].buffers.get() + bucket * block;
+                    for (std::ptrdiff_t i = 0 ; i < locals[id].fill[bucket] ; ++i) {
+                        put(std::move(buffer[i]));
+                        buffer[i].~T();
+                    }
+                }
+                if (bucket == overflow_bucket) {
+                    for (std::ptrdiff_t i = 0 ; i < block ; ++i) {
+                        put(std::move(overflow.get()[i]));
+                        overflow.get()[i].~T();
+                    }
+                }
+            }
+
+            return result;
+        }
+
+        // Whether the partitioning step split the range or found all
+        // of its elements equivalent, an unlucky sample could put all
+        // the elements in a single bucket otherwise
+        template<typename Key, typename Compare, typename Projection>
+        auto made_progress(const partition_result<Key, Compare, Projection>& result,
+                           std::ptrdiff_t size)
+            -> bool
+        {
+            const auto& bounds = result.bounds;
+            for (std::ptrdiff_t bucket = 0 ; bucket + 1 < static_cast<std::ptrdiff_t>(bounds.size()) ; ++bucket) {
+                if (bounds[bucket + 1] - bounds[bucket] == size) {
+                    return result.classify.is_equal_bucket(bucket);
+                }
+            }
+            return true;
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Sequential samplesort
+
+        template<typename RandomAccessIterator, typename T,
+                 typename Compare, typename Projection>
+        auto sequential_sort(RandomAccessIterator first, RandomAccessIterator last,
+                             Compare compare, Projection projection,
+                             local_data<T>& local, int log_max)
+            -> void
+        {
+            std::ptrdiff_t size = last - first;
+            if (size <= base_case_size) {
+                pdqsort(std::move(first), std::move(last),
+                        std::move(compare), std::move(projection));
+                return;
+            }
+
+            auto result = partition<null_mutex>(first, last, compare, projection, &local, 1, log_max);
+            if (not made_progress(result, size)) {
+                pdqsort(std::move(first), std::move(last),
+                        std::move(compare), std::move(projection));
+                return;
+            }
+
+            const auto& bounds = result.bounds;
+            for (std::ptrdiff_t bucket = 0 ; bucket + 1 < static_cast<std::ptrdiff_t>(bounds.size()) ; ++bucket) {
+                if (result.classify.is_equal_bucket(bucket)) continue;
+                sequential_sort(first + bounds[bucket], first + bounds[bucket + 1],
+                                compare, projection, local, log_max);
+            }
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Task queues for the parallel recursion: every thread pops
+        // the most recent tasks from its own queue and steals the
+        // oldest ones, usually the largest, from the other queues
+
+        struct task_queue
+        {
+            std::mutex mutex;
+            std::deque<std::pair<std::ptrdiff_t, std::ptrdiff_t>> tasks;
+        };
+    }
+
+    ////////////////////////////////////////////////////////////
+    // In-place parallel super scalar samplesort (IPS4o)
+
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    auto ips4o(RandomAccessIterator first, RandomAccessIterator last,
+               Compare compare, Projection projection, int num_threads,
+               std::false_type /* copyable keys */)
+        -> void
+    {
+        // The splitters can't be copied out of the collection
+        (void) num_threads;
+        pdqsort(std::move(first), std::move(last),
+                std::move(compare), std::move(projection));
+    }
+
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    auto ips4o(RandomAccessIterator first, RandomAccessIterator last,
+               Compare compare, Projection projection, int num_threads,
+               std::true_type /* copyable keys */)
+        -> void
+    {
+        using namespace ips4o_detail;
+        using value_type = remove_cvref_t<rvalue_reference_t<RandomAccessIterator>>;
+
+        std::ptrdiff_t size = last - first;
+        if (size <= base_case_size) {
+            pdqsort(std::move(first), std::move(last),
+                    std::move(compare), std::move(projection));
+            return;
+        }
+        if (size < parallel_threshold) {
+            num_threads = 1;
+        }
+
+        // The number of buckets only decreases with the size
+        // of the ranges, so the buffers are allocated once
+        std::ptrdiff_t max_buckets = std::ptrdiff_t(2) << log_buckets_for<value_type>(size, log_max_buckets);
+        std::vector<local_data<value_type>> locals;
+        locals.reserve(num_threads);
+        for (int id = 0 ; id < num_threads ; ++id) {
+            locals.emplace_back(max_buckets, block_size<value_type>());
+        }
+
+        if (num_threads == 1) {
+            sequential_sort(std::move(first), std::move(last),
+                            std::move(compare), std::move(projection),
+                            locals.front(), log_max_buckets);
+            return;
+        }
+
+        // Partition the whole range with all the threads
+        auto result = partition<std::mutex>(first, last, compare, projection,
+                                            locals.data(), num_threads, log_max_buckets);
+
+        // Then sort the buckets in parallel with work stealing,
+        // partitioning them further sequentially
+        std::vector<task_queue> queues(num_threads);
+        std::atomic<std::ptrdiff_t> pending(0);
+        std::atomic<bool> failed(false);
+
+        auto push_buckets = [&](task_queue& queue, std::ptrdiff_t offset,
+                                const std::vector<std::ptrdiff_t>& bounds,
+                                auto& classifier, int spread) {
+            for (std::ptrdiff_t bucket = 0 ; bucket + 1 < static_cast<std::ptrdiff_t>(bounds.size()) ; ++bucket) {
+                if (classifier.is_equal_bucket(bucket)) continue;
+                if (bounds[bucket + 1] - bounds[bucket] < 2) continue;
+                auto& target = spread ? queues[bucket % spread] : queue;
+                std::lock_guard<std::mutex> lock(target.mutex);
+                target.tasks.emplace_back(offset + bounds[bucket], offset + bounds[bucket + 1]);
+                ++pending;
+            }
+        };
+        push_buckets(queues.front(), 0, result.bounds, result.classify, num_threads);
+
+        run_in_parallel(num_threads, [&](int id) {
+            try {
+                while (pending > 0 && not failed) {
+                    std::pair<std::ptrdiff_t, std::ptrdiff_t> task;
+                    bool found = false;
+                    for (int i = 0 ; i < num_threads && not found ; ++i) {
+                        auto& queue = queues[(id + i) % num_threads];
+                        std::lock_guard<std::mutex> lock(queue.mutex);
+                        if (not queue.tasks.empty()) {
+                            if (i == 0) {
+                                task = queue.tasks.back();
+                                queue.tasks.pop_back();
+                            } else {
+                                task = queue.tasks.front();
+                                queue.tasks.pop_front();
+                            }
+                            found = true;
+                        }
+                    }
+                    if (not found) {
+                        std::this_thread::yield();
+                        continue;
+                    }
+
+                    auto task_first = first + task.first;
+                    auto task_last = first + task.second;
+                    if (task.second - task.first <= base_case_size) {
+                        pdqsort(task_first, task_last, compare, projection);
+                    } else {
+                        auto sub_result = partition<null_mutex>(task_first, task_last,
+                                                                compare, projection,
+                                                                &locals[id], 1, log_max_buckets);
+                        if (made_progress(sub_result, task.second - task.first)) {
+                            push_buckets(queues[id], task.first, sub_result.bounds,
+                                         sub_result.classify, 0);
+                        } else {
+                            pdqsort(task_first, task_last, compare, projection);
+                        }
+                    }
+                    --pending;
+                }
+            } catch (...) {
+                failed = true;
+                throw;
+            }
+        });
+    }
+
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    auto ips4o(RandomAccessIterator first, RandomAccessIterator last,
+               Compare compare, Projection projection, int num_threads)
+        -> void
+    {
+        using key_type = projected_t<RandomAccessIterator, Projection>;
+        ips4o(std::move(first), std::move(last),
+              std::move(compare), std::move(projection), num_threads,
+              std::is_copy_constructible<key_type>{});
+    }
+}}
+
+#endif // CPPSORT_DETAIL_IPS4O_H_
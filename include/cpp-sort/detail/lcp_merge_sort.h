@@ -0,0 +1,191 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_DETAIL_LCP_MERGE_SORT_H_
+#define CPPSORT_DETAIL_LCP_MERGE_SORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+#include <cpp-sort/utility/apply_permutation.h>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/functional.h>
+#include "insertion_sort.h"
+#include "string_keys.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    namespace lcp_merge_detail
+    {
+        // Ranges smaller than this are sorted with insertion sort
+        constexpr std::ptrdiff_t small_sort_size = 16;
+
+        ////////////////////////////////////////////////////////////
+        // Merge two sorted runs along with their LCP arrays, where
+        // lcp[i] is the LCP of the strings i-1 and i of a run
+        //
+        // For the heads of both runs, the merge keeps track of
+        // their LCP with the last merged string: the head sharing
+        // the longest prefix with it is the smallest, and only
+        // when both LCPs are equal are the strings compared, from
+        // the first character that isn't known to be equal
+
+        inline auto lcp_merge(const string_entry* first1, std::ptrdiff_t size1, const std::size_t* lcp1,
+                              const string_entry* first2, std::ptrdiff_t size2, const std::size_t* lcp2,
+                              string_entry* out, std::size_t* out_lcp)
+            -> void
+        {
+            std::ptrdiff_t i = 0, j = 0;
+            std::size_t h1 = 0, h2 = 0;
+            while (i < size1 && j < size2) {
+                if (h1 > h2) {
+                    *out++ = first1[i];
+                    *out_lcp++ = h1;
+                    if (++i < size1) h1 = lcp1[i];
+                } else if (h1 < h2) {
+                    *out++ = first2[j];
+                    *out_lcp++ = h2;
+                    if (++j < size2) h2 = lcp2[j];
+                } else {
+                    const auto& str1 = first1[i].str;
+                    const auto& str2 = first2[j].str;
+                    auto h = common_prefix_length(str1, str2, h1);
+                    bool second_less = h < str1.size && (h == str2.size || str2.data[h] < str1.data[h]);
+                    if (second_less) {
+                        *out++ = first2[j];
+                        *out_lcp++ = h2;
+                        h1 = h;
+                        if (++j < size2) h2 = lcp2[j];
+                    } else {
+                        // Equal strings are taken from the first
+                        // run to keep the sort stable
+                        *out++ = first1[i];
+                        *out_lcp++ = h1;
+                        h2 = h;
+                        if (++i < size1) h1 = lcp1[i];
+                    }
+                }
+            }
+
+            if (i < size1) {
+                *out++ = first1[i];
+                *out_lcp++ = h1;
+                out = std::copy(first1 + i + 1, first1 + size1, out);
+                std::copy(lcp1 + i + 1, lcp1 + size1, out_lcp);
+            } else if (j < size2) {
+                *out++ = first2[j];
+                *out_lcp++ = h2;
+                out = std::copy(first2 + j + 1, first2 + size2, out);
+                std::copy(lcp2 + j + 1, lcp2 + size2, out_lcp);
+            }
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Top-down merge sort of the entries and their LCP array,
+        // the buffers must be as big as the sorted range
+
+        inline auto lcp_merge_sort(string_entry* first, std::ptrdiff_t size, std::size_t* lcp,
+                                   string_entry* buffer, std::size_t* buffer_lcp)
+            -> void
+        {
+            if (size < small_sort_size) {
+                insertion_sort(first, first + size, [](const string_entry& lhs, const string_entry& rhs) {
+                    return suffix_less(lhs.str, rhs.str, 0);
+                }, utility::identity{});
+                lcp[0] = 0;
+                for (std::ptrdiff_t i = 1 ; i < size ; ++i) {
+                    lcp[i] = common_prefix_length(first[i - 1].str, first[i].str, 0);
+                }
+                return;
+            }
+
+            auto half = size / 2;
+            lcp_merge_sort(first, half, lcp, buffer, buffer_lcp);
+            lcp_merge_sort(first + half, size - half, lcp + half, buffer, buffer_lcp);
+
+            // Nothing to merge when the runs are already in order
+            const auto& last1 = first[half - 1].str;
+            const auto& first2 = first[half].str;
+            auto h = common_prefix_length(last1, first2, 0);
+            if (h == last1.size || (h < first2.size && last1.data[h] < first2.data[h])) {
+                lcp[half] = h;
+                return;
+            }
+
+            lcp_merge(first, half, lcp, first + half, size - half, lcp + half,
+                      buffer, buffer_lcp);
+            std::copy(buffer, buffer + size, first);
+            std::copy(buffer_lcp, buffer_lcp + size, lcp);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Stable sort of the strings, reorders the original
+    // collection once at the end and writes the LCP array to
+    // lcp when it is not null
+
+    template<typename RandomAccessIterator, typename Projection>
+    auto lcp_merge_sort(RandomAccessIterator first, RandomAccessIterator last,
+                        Projection projection, std::size_t* lcp)
+        -> void
+    {
+        auto&& proj = utility::as_function(projection);
+
+        auto size = last - first;
+        if (lcp && size > 0) {
+            lcp[0] = 0;
+        }
+        if (size < 2) return;
+
+        std::vector<string_entry> entries;
+        entries.reserve(size);
+        for (decltype(size) i = 0 ; i < size ; ++i) {
+            entries.push_back({ make_string_ref(proj(first[i])), static_cast<std::size_t>(i) });
+        }
+
+        // The merge needs the LCP array even when it isn't requested
+        std::vector<std::size_t> lcp_storage;
+        if (lcp == nullptr) {
+            lcp_storage.resize(size);
+            lcp = lcp_storage.data();
+        }
+        std::vector<string_entry> buffer(size);
+        std::vector<std::size_t> buffer_lcp(size);
+        lcp_merge_detail::lcp_merge_sort(entries.data(), size, lcp,
+                                         buffer.data(), buffer_lcp.data());
+
+        std::vector<std::size_t> indices;
+        indices.reserve(size);
+        for (const auto& entry: entries) {
+            indices.push_back(entry.index);
+        }
+        utility::apply_permutation(indices.begin(), indices.end(), first);
+    }
+}}
+
+#endif // CPPSORT_DETAIL_LCP_MERGE_SORT_H_
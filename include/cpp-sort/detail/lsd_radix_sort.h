@@ -0,0 +1,382 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_DETAIL_LSD_RADIX_SORT_H_
+#define CPPSORT_DETAIL_LSD_RADIX_SORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cpp-sort/utility/iter_move.h>
+#include "bitops.h"
+#include "config.h"
+#include "insertion_sort.h"
+#include "iterator_traits.h"
+#include "memory.h"
+#include "minmax_element.h"
+#include "move.h"
+#include "total_order_key.h"
+#include "type_traits.h"
+
+#if CPPSORT_SIMD_X86_DISPATCH && defined(__SSE2__)
+#   include <emmintrin.h>
+#endif
+
+namespace cppsort
+{
+namespace detail
+{
+    //
+    // Least significant digit radix sort: the keys returned by
+    // the key projection are unsigned integers, sorted one digit
+    // of DigitBits bits at a time by moving the elements back
+    // and forth between the collection and a buffer
+    //
+    // The smallest key is subtracted from every key, and the
+    // histograms of every digit are computed in a single pass
+    // before the sort starts, which also allows to skip the
+    // passes where every key has the same digit: small keys
+    // stored in wide integers only pay for the digits that
+    // actually differ
+    //
+
+    template<int DigitBits, typename Key>
+    constexpr auto lsd_radix_digit(Key key, int pass) noexcept
+        -> std::size_t
+    {
+        return static_cast<std::size_t>(key >> (pass * DigitBits))
+             & ((std::size_t(1) << DigitBits) - 1);
+    }
+
+    template<std::size_t Radix>
+    auto lsd_radix_offsets(std::size_t* counts) noexcept
+        -> void
+    {
+        std::size_t sum = 0;
+        for (std::size_t digit = 0 ; digit < Radix ; ++digit) {
+            auto count = counts[digit];
+            counts[digit] = sum;
+            sum += count;
+        }
+    }
+
+    template<int DigitBits, typename InputIterator, typename OutputIterator,
+             typename KeyProjection>
+    auto lsd_radix_scatter(InputIterator first, InputIterator last, OutputIterator out,
+                           std::size_t* offsets, int pass, KeyProjection& key_projection)
+        -> void
+    {
+        using utility::iter_move;
+        for (; first != last ; ++first) {
+            auto digit = lsd_radix_digit<DigitBits>(key_projection(*first), pass);
+            out[offsets[digit]++] = iter_move(first);
+        }
+    }
+
+    template<int DigitBits, typename InputIterator, typename T, typename KeyProjection>
+    auto lsd_radix_scatter_construct(InputIterator first, InputIterator last, T* out,
+                                     std::size_t* offsets, int pass, KeyProjection& key_projection)
+        -> void
+    {
+        using utility::iter_move;
+        for (; first != last ; ++first) {
+            auto digit = lsd_radix_digit<DigitBits>(key_projection(*first), pass);
+            ::new(out + offsets[digit]++) T(iter_move(first));
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Software write-combining: for large collections, elements
+    // are first gathered in per-digit staging buffers the size
+    // of a cache line, which are written to their destination
+    // only once full, with non-temporal stores when possible;
+    // the scatter then writes whole cache lines instead of
+    // touching up to Radix far apart memory locations for every
+    // element, which avoids most of the cache and TLB misses
+
+    constexpr std::size_t lsd_radix_line_size = 64;
+
+    // Below that many bytes, the collection and the buffer mostly
+    // stay in the cache and the regular scatter is faster
+    constexpr std::size_t lsd_radix_staging_threshold = std::size_t(1) << 24;
+
+    template<typename RandomAccessIterator, int DigitBits>
+    struct can_lsd_radix_stage:
+        std::integral_constant<
+            bool,
+            // Staging buffers have to fit comfortably in the L2 cache
+            DigitBits <= 12 &&
+            std::is_trivially_copyable<value_type_t<RandomAccessIterator>>::value &&
+            // Smaller elements were measured to be sorted faster
+            // without staging buffers
+            (sizeof(value_type_t<RandomAccessIterator>) == 8 ||
+             sizeof(value_type_t<RandomAccessIterator>) == 16) &&
+            (std::is_pointer<RandomAccessIterator>::value ||
+             std::is_same<
+                RandomAccessIterator,
+                typename std::vector<value_type_t<RandomAccessIterator>>::iterator
+             >::value)
+        >
+    {};
+
+    inline auto lsd_radix_flush_line(void* dest, const void* line) noexcept
+        -> void
+    {
+#if CPPSORT_SIMD_X86_DISPATCH && defined(__SSE2__)
+        if (reinterpret_cast<std::uintptr_t>(dest) % 16 == 0) {
+            auto dest_ptr = static_cast<__m128i*>(dest);
+            auto line_ptr = static_cast<const __m128i*>(line);
+            _mm_stream_si128(dest_ptr, _mm_load_si128(line_ptr));
+            _mm_stream_si128(dest_ptr + 1, _mm_load_si128(line_ptr + 1));
+            _mm_stream_si128(dest_ptr + 2, _mm_load_si128(line_ptr + 2));
+            _mm_stream_si128(dest_ptr + 3, _mm_load_si128(line_ptr + 3));
+            return;
+        }
+#endif
+        std::memcpy(dest, line, lsd_radix_line_size);
+    }
+
+    template<int DigitBits, typename T, typename KeyProjection>
+    auto lsd_radix_staged_scatter(const T* first, const T* last, T* out,
+                                  std::size_t* offsets, int pass, KeyProjection& key_projection,
+                                  T* staging, unsigned char* fill, unsigned char* limit)
+        -> void
+    {
+        constexpr std::size_t radix = std::size_t(1) << DigitBits;
+        constexpr std::size_t line_elements = lsd_radix_line_size / sizeof(T);
+
+        // The first write to each bucket only goes up to the next
+        // cache line boundary, so that the following ones are
+        // aligned when the elements are
+        for (std::size_t digit = 0 ; digit < radix ; ++digit) {
+            auto address = reinterpret_cast<std::uintptr_t>(out + offsets[digit]);
+            auto misalignment = address % lsd_radix_line_size;
+            fill[digit] = 0;
+            limit[digit] = static_cast<unsigned char>(
+                misalignment == 0 || misalignment % sizeof(T) != 0 ?
+                    line_elements :
+                    (lsd_radix_line_size - misalignment) / sizeof(T)
+            );
+        }
+
+        for (; first != last ; ++first) {
+            auto digit = lsd_radix_digit<DigitBits>(key_projection(*first), pass);
+            T* line = staging + digit * line_elements;
+            std::memcpy(line + fill[digit], first, sizeof(T));
+            if (++fill[digit] == limit[digit]) {
+                T* dest = out + offsets[digit];
+                if (fill[digit] == line_elements) {
+                    lsd_radix_flush_line(dest, line);
+                } else {
+                    std::memcpy(dest, line, fill[digit] * sizeof(T));
+                }
+                offsets[digit] += fill[digit];
+                fill[digit] = 0;
+                limit[digit] = static_cast<unsigned char>(line_elements);
+            }
+        }
+
+        // Write what remains in the staging buffers
+        for (std::size_t digit = 0 ; digit < radix ; ++digit) {
+            if (fill[digit] != 0) {
+                std::memcpy(out + offsets[digit], staging + digit * line_elements,
+                            fill[digit] * sizeof(T));
+                offsets[digit] += fill[digit];
+            }
+        }
+#if CPPSORT_SIMD_X86_DISPATCH && defined(__SSE2__)
+        // Make the non-temporal stores visible before the next pass
+        _mm_sfence();
+#endif
+    }
+
+    template<int DigitBits, typename RandomAccessIterator, typename T, typename KeyProjection>
+    auto lsd_radix_staged_passes(RandomAccessIterator first, T* buffer, std::ptrdiff_t size,
+                                 std::size_t* counts, const int* active_passes, int nb_active_passes,
+                                 KeyProjection& key_projection, std::true_type)
+        -> bool
+    {
+        if (static_cast<std::size_t>(size) * sizeof(T) < lsd_radix_staging_threshold) {
+            return false;
+        }
+
+        constexpr std::size_t radix = std::size_t(1) << DigitBits;
+
+        // Staging buffers aligned on a cache line boundary
+        std::unique_ptr<unsigned char, operator_deleter> memory(
+            static_cast<unsigned char*>(::operator new((radix + 1) * lsd_radix_line_size))
+        );
+        auto address = reinterpret_cast<std::uintptr_t>(memory.get());
+        T* staging = reinterpret_cast<T*>(
+            (address + lsd_radix_line_size - 1) & ~std::uintptr_t(lsd_radix_line_size - 1)
+        );
+        std::vector<unsigned char> fill(radix);
+        std::vector<unsigned char> limit(radix);
+
+        T* data = std::addressof(*first);
+        T* in = data;
+        T* out = buffer;
+        for (int pass_index = 0 ; pass_index < nb_active_passes ; ++pass_index) {
+            int pass = active_passes[pass_index];
+            auto offsets = counts + pass * radix;
+            lsd_radix_offsets<radix>(offsets);
+            lsd_radix_staged_scatter<DigitBits>(in, in + size, out, offsets, pass, key_projection,
+                                                staging, fill.data(), limit.data());
+            std::swap(in, out);
+        }
+
+        if (in != data) {
+            std::memcpy(data, in, size * sizeof(T));
+        }
+        return true;
+    }
+
+    template<int DigitBits, typename RandomAccessIterator, typename T, typename KeyProjection>
+    auto lsd_radix_staged_passes(RandomAccessIterator, T*, std::ptrdiff_t,
+                                 std::size_t*, const int*, int,
+                                 KeyProjection&, std::false_type)
+        -> bool
+    {
+        return false;
+    }
+
+    template<int DigitBits, typename RandomAccessIterator, typename KeyProjection>
+    auto lsd_radix_sort(RandomAccessIterator first, RandomAccessIterator last,
+                        KeyProjection key_projection)
+        -> void
+    {
+        using rvalue_type = remove_cvref_t<rvalue_reference_t<RandomAccessIterator>>;
+        using key_type = remove_cvref_t<decltype(key_projection(*first))>;
+        static_assert(
+            std::is_unsigned<key_type>::value,
+            "lsd_radix_sort requires unsigned integer keys"
+        );
+
+        constexpr int max_passes = (std::numeric_limits<key_type>::digits + DigitBits - 1) / DigitBits;
+        constexpr std::size_t radix = std::size_t(1) << DigitBits;
+
+        auto size = last - first;
+        if (size < 2) return;
+        if (size <= 32) {
+            insertion_sort(std::move(first), std::move(last),
+                           std::less<>{}, std::move(key_projection));
+            return;
+        }
+
+        // Subtract the smallest key from every key: only the digits
+        // needed to represent the range of the keys are sorted, even
+        // when a narrow range of keys crosses a digit boundary
+        auto bounds = minmax_key(first, last, key_projection);
+        auto range = static_cast<key_type>(bounds.second - bounds.first);
+        if (range == 0) return;
+        const int passes = static_cast<int>(detail::log2(range)) / DigitBits + 1;
+        rebased_key_projection<KeyProjection&, key_type> rebased_projection{
+            key_projection, bounds.first, 0
+        };
+
+        // Compute the histograms of every digit at once
+        std::vector<std::size_t> counts(passes * radix, 0);
+        for (auto it = first ; it != last ; ++it) {
+            auto key = rebased_projection(*it);
+            for (int pass = 0 ; pass < passes ; ++pass) {
+                ++counts[pass * radix + lsd_radix_digit<DigitBits>(key, pass)];
+            }
+        }
+
+        // Only keep the passes where the digits of the keys differ
+        int active_passes[max_passes];
+        int nb_active_passes = 0;
+        auto first_key = rebased_projection(*first);
+        for (int pass = 0 ; pass < passes ; ++pass) {
+            auto digit = lsd_radix_digit<DigitBits>(first_key, pass);
+            if (counts[pass * radix + digit] != static_cast<std::size_t>(size)) {
+                active_passes[nb_active_passes++] = pass;
+            }
+        }
+        if (nb_active_passes == 0) return;
+
+        std::unique_ptr<rvalue_type, operator_deleter> buffer(
+            static_cast<rvalue_type*>(::operator new(size * sizeof(rvalue_type)))
+        );
+        destruct_n<rvalue_type> d(0);
+        std::unique_ptr<rvalue_type, destruct_n<rvalue_type>&> h2(buffer.get(), d);
+        auto buffer_first = buffer.get();
+        auto buffer_last = buffer_first + size;
+
+        if (lsd_radix_staged_passes<DigitBits>(first, buffer_first, size, counts.data(),
+                                               active_passes, nb_active_passes, rebased_projection,
+                                               can_lsd_radix_stage<RandomAccessIterator, DigitBits>{})) {
+            return;
+        }
+
+        int pass_index = 0;
+        if (std::is_trivially_destructible<rvalue_type>::value) {
+            // Nothing to destroy in the buffer afterwards, elements
+            // can directly be scattered into uninitialized memory
+            int pass = active_passes[pass_index++];
+            auto offsets = counts.data() + pass * radix;
+            lsd_radix_offsets<radix>(offsets);
+            lsd_radix_scatter_construct<DigitBits>(first, last, buffer_first,
+                                                   offsets, pass, rebased_projection);
+        } else {
+            // Construct the buffer elements in order so that they
+            // can be destroyed properly if something goes wrong
+            using utility::iter_move;
+            auto ptr = buffer_first;
+            for (auto it = first ; it != last ; ++d, (void) ++it, ++ptr) {
+                ::new(ptr) rvalue_type(iter_move(it));
+            }
+        }
+
+        bool in_buffer = true;
+        for (; pass_index < nb_active_passes ; ++pass_index) {
+            int pass = active_passes[pass_index];
+            auto offsets = counts.data() + pass * radix;
+            lsd_radix_offsets<radix>(offsets);
+            if (in_buffer) {
+                lsd_radix_scatter<DigitBits>(buffer_first, buffer_last, first,
+                                             offsets, pass, rebased_projection);
+            } else {
+                lsd_radix_scatter<DigitBits>(first, last, buffer_first,
+                                             offsets, pass, rebased_projection);
+            }
+            in_buffer = not in_buffer;
+        }
+
+        if (in_buffer) {
+            detail::move(buffer_first, buffer_last, first);
+        }
+    }
+}}
+
+#endif // CPPSORT_DETAIL_LSD_RADIX_SORT_H_
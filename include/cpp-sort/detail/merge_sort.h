@@ -28,13 +28,16 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <iterator>
+#include <type_traits>
 #include <utility>
 #include <cpp-sort/utility/as_function.h>
+#include "branchless_merge.h"
 #include "bubble_sort.h"
 #include "inplace_merge.h"
 #include "insertion_sort.h"
 #include "iterator_traits.h"
 #include "memory.h"
+#include "simd_merge.h"
 #include "type_traits.h"
 
 namespace cppsort
@@ -44,6 +47,57 @@ namespace detail
     template<typename T>
     using buffer_ptr = temporary_buffer<remove_cvref_t<T>>;
 
+    template<typename BidirectionalIterator, typename Compare, typename Projection>
+    auto merge_halves(BidirectionalIterator first, BidirectionalIterator middle,
+                      BidirectionalIterator last,
+                      difference_type_t<BidirectionalIterator> len1,
+                      difference_type_t<BidirectionalIterator> len2,
+                      buffer_ptr<rvalue_reference_t<BidirectionalIterator>>& buffer,
+                      Compare compare, Projection projection,
+                      std::false_type /* branchless */)
+        -> void
+    {
+        // Try to increase the memory buffer if it not big enough
+        buffer.try_grow(len1);
+
+        // Merge the sorted partitions in-place
+        inplace_merge(std::move(first), std::move(middle), std::move(last),
+                      std::move(compare), std::move(projection),
+                      len1, len2, buffer.data(), buffer.size());
+    }
+
+    template<typename BidirectionalIterator, typename Compare, typename Projection>
+    auto merge_halves(BidirectionalIterator first, BidirectionalIterator middle,
+                      BidirectionalIterator last,
+                      difference_type_t<BidirectionalIterator> len1,
+                      difference_type_t<BidirectionalIterator> len2,
+                      buffer_ptr<rvalue_reference_t<BidirectionalIterator>>& buffer,
+                      Compare compare, Projection projection,
+                      std::true_type /* branchless */)
+        -> void
+    {
+        // The branchless merge needs room for both partitions
+        buffer.try_grow(len1 + len2);
+
+        // Vectorized merge, only needs room for the left partition
+        if (buffer.size() >= len1 &&
+            is_simd_merge_available<BidirectionalIterator, Compare, Projection>()) {
+            simd_inplace_merge(std::move(first), std::move(middle), std::move(last),
+                               buffer.data(), std::move(compare), std::move(projection));
+            return;
+        }
+
+        if (buffer.size() >= len1 + len2) {
+            branchless_merge(std::move(first), std::move(last), len1, len2,
+                             buffer.data(), std::move(compare), std::move(projection));
+            return;
+        }
+
+        merge_halves(std::move(first), std::move(middle), std::move(last),
+                     len1, len2, buffer, std::move(compare), std::move(projection),
+                     std::false_type{});
+    }
+
     template<typename ForwardIterator, typename Compare, typename Projection>
     auto merge_sort_impl(ForwardIterator first, difference_type_t<ForwardIterator> size,
                          buffer_ptr<rvalue_reference_t<ForwardIterator>>&& buffer,
@@ -74,7 +128,8 @@ namespace detail
         ));
 
         // Shrink the left partition to merge
-        auto&& middle_proj = proj(*middle);
+        decltype(auto) middle_value = *middle;
+        auto&& middle_proj = proj(middle_value);
         while (first != middle && not comp(middle_proj, proj(*first))) {
             ++first;
             --size_left;
@@ -125,7 +180,8 @@ namespace detail
         ));
 
         // Shrink the left partition to merge
-        auto&& middle_proj = proj(*middle);
+        decltype(auto) middle_value = *middle;
+        auto&& middle_proj = proj(middle_value);
         while (first != middle && not comp(middle_proj, proj(*first))) {
             ++first;
             --size_left;
@@ -134,14 +190,10 @@ namespace detail
             return std::move(buffer);
         }
 
-        // Try to increase the memory buffer if it not big enough
-        buffer.try_grow(size_left);
-
-        // Merge the sorted partitions in-place
-        inplace_merge(std::move(first), std::move(middle), std::move(last),
-                      std::move(compare), std::move(projection),
-                      size_left, size - (size / 2),
-                      buffer.data(), buffer.size());
+        merge_halves(std::move(first), std::move(middle), std::move(last),
+                     size_left, size - (size / 2), buffer,
+                     std::move(compare), std::move(projection),
+                     can_merge_branchless<BidirectionalIterator, Compare, Projection>{});
 
         return std::move(buffer);
     }
@@ -23,6 +23,7 @@
 #include <utility>
 #include <cpp-sort/utility/as_function.h>
 #include "config.h"
+#include "type_traits.h"
 
 namespace cppsort
 {
@@ -88,6 +89,30 @@ namespace detail
         return unchecked_minmax_element(std::move(begin), std::move(end),
                                         std::move(compare), std::move(projection));
     }
+
+    template<typename ForwardIterator, typename KeyProjection>
+    auto minmax_key(ForwardIterator begin, ForwardIterator end,
+                    KeyProjection& key_projection)
+        -> std::pair<
+            remove_cvref_t<decltype(key_projection(*begin))>,
+            remove_cvref_t<decltype(key_projection(*begin))>
+        >
+    {
+        // Minimum and maximum values of integer keys, assumes that
+        // the collection is not empty: there is no dependency
+        // between iterations, which allows compilers to vectorize
+        // the loop when the keys are read from contiguous memory
+        CPPSORT_ASSUME(begin != end);
+
+        auto min = key_projection(*begin);
+        auto max = min;
+        while (++begin != end) {
+            auto key = key_projection(*begin);
+            min = key < min ? key : min;
+            max = max < key ? key : max;
+        }
+        return { min, max };
+    }
 }}
 
 #endif // CPPSORT_DETAIL_MINMAX_ELEMENT_H_
@@ -0,0 +1,178 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_DETAIL_MULTIKEY_QUICKSORT_H_
+#define CPPSORT_DETAIL_MULTIKEY_QUICKSORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include <cpp-sort/utility/apply_permutation.h>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/functional.h>
+#include "insertion_sort.h"
+#include "string_keys.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    namespace multikey_detail
+    {
+        // Ranges smaller than this are sorted with insertion sort
+        constexpr std::ptrdiff_t small_sort_size = 16;
+
+        // Byte of the string at depth shifted by one, 0 past the
+        // end of the string so that shorter strings come first
+        inline auto char_at(const string_entry& entry, std::size_t depth)
+            -> int
+        {
+            return depth < entry.str.size ? entry.str.data[depth] + 1 : 0;
+        }
+
+        inline auto median_of_3(int a, int b, int c)
+            -> int
+        {
+            if (a < b) {
+                return b < c ? b : (a < c ? c : a);
+            }
+            return a < c ? a : (b < c ? c : b);
+        }
+
+        // Sort strings whose first depth bytes are equal, then
+        // compute the LCP of the neighbours starting at depth
+        inline auto small_sort(string_entry* first, string_entry* last,
+                               std::size_t* lcp, std::size_t depth)
+            -> void
+        {
+            insertion_sort(first, last, [depth](const string_entry& lhs, const string_entry& rhs) {
+                return suffix_less(lhs.str, rhs.str, depth);
+            }, utility::identity{});
+
+            if (lcp == nullptr) return;
+            for (std::ptrdiff_t i = 1 ; i < last - first ; ++i) {
+                lcp[i] = common_prefix_length(first[i - 1].str, first[i].str, depth);
+            }
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Multikey quicksort: three-way partition of the strings
+        // around the byte at depth of a pivot, only the strings
+        // whose byte is equal to that of the pivot move to the
+        // next byte
+        //
+        // When lcp is not null, lcp[i] receives the LCP of the
+        // strings i-1 and i for every i > 0: the strings of two
+        // adjacent partitions differ at depth, which gives the
+        // LCP at the boundaries for free
+
+        inline auto multikey_quicksort(string_entry* first, string_entry* last,
+                                       std::size_t* lcp, std::size_t depth)
+            -> void
+        {
+            while (last - first > small_sort_size) {
+                auto size = last - first;
+                int pivot = median_of_3(char_at(first[0], depth),
+                                        char_at(first[size / 2], depth),
+                                        char_at(last[-1], depth));
+
+                // [first, lt) < pivot, [lt, gt) == pivot, [gt, last) > pivot
+                auto lt = first;
+                auto gt = last;
+                for (auto it = first ; it != gt ;) {
+                    int c = char_at(*it, depth);
+                    if (c < pivot) {
+                        std::swap(*lt++, *it++);
+                    } else if (pivot < c) {
+                        std::swap(*it, *--gt);
+                    } else {
+                        ++it;
+                    }
+                }
+
+                multikey_quicksort(first, lt, lcp, depth);
+                multikey_quicksort(gt, last, lcp ? lcp + (gt - first) : nullptr, depth);
+                if (lcp) {
+                    if (lt != first) lcp[lt - first] = depth;
+                    if (gt != last) lcp[gt - first] = depth;
+                }
+
+                if (pivot == 0) {
+                    // The strings of the middle partition all
+                    // end at depth: they are equal
+                    if (lcp) {
+                        for (auto it = lt + 1 ; it < gt ; ++it) {
+                            lcp[it - first] = depth;
+                        }
+                    }
+                    return;
+                }
+
+                if (lcp) lcp += lt - first;
+                first = lt;
+                last = gt;
+                ++depth;
+            }
+            small_sort(first, last, lcp, depth);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Sort the strings and reorder the original collection once
+    // at the end, writes the LCP array to lcp when it is not
+    // null
+
+    template<typename RandomAccessIterator, typename Projection>
+    auto multikey_quicksort(RandomAccessIterator first, RandomAccessIterator last,
+                            Projection projection, std::size_t* lcp)
+        -> void
+    {
+        auto&& proj = utility::as_function(projection);
+
+        auto size = last - first;
+        if (lcp && size > 0) {
+            lcp[0] = 0;
+        }
+        if (size < 2) return;
+
+        std::vector<string_entry> entries;
+        entries.reserve(size);
+        for (decltype(size) i = 0 ; i < size ; ++i) {
+            entries.push_back({ make_string_ref(proj(first[i])), static_cast<std::size_t>(i) });
+        }
+
+        multikey_detail::multikey_quicksort(entries.data(), entries.data() + size, lcp, 0);
+
+        std::vector<std::size_t> indices;
+        indices.reserve(size);
+        for (const auto& entry: entries) {
+            indices.push_back(entry.index);
+        }
+        utility::apply_permutation(indices.begin(), indices.end(), first);
+    }
+}}
+
+#endif // CPPSORT_DETAIL_MULTIKEY_QUICKSORT_H_
@@ -457,6 +457,68 @@ namespace detail
             return pivot_pos;
         }
 
+        // Moves the median of 3 or the pseudomedian of 9 of [begin, end) to *begin so that
+        // it can be used as a pivot by the partitioning functions above. Assumes that
+        // [begin, end) is at least insertion_sort_threshold long.
+        template<typename RandomAccessIterator, typename Compare, typename Projection>
+        auto choose_pivot(RandomAccessIterator begin, RandomAccessIterator end,
+                          Compare compare, Projection projection)
+            -> void
+        {
+            using utility::iter_swap;
+            using difference_type = difference_type_t<RandomAccessIterator>;
+
+            difference_type size = std::distance(begin, end);
+            difference_type s2 = size / 2;
+            if (size > ninther_threshold) {
+                iter_sort3(begin, begin + s2, end - 1, compare, projection);
+                iter_sort3(begin + 1, begin + (s2 - 1), end - 2, compare, projection);
+                iter_sort3(begin + 2, begin + (s2 + 1), end - 3, compare, projection);
+                iter_sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1), compare, projection);
+                iter_swap(begin, begin + s2);
+            } else {
+                iter_sort3(begin + s2, begin, end - 1, std::move(compare), std::move(projection));
+            }
+        }
+
+        // Swaps a few elements on both sides of a highly unbalanced partition to break
+        // the patterns that led to it.
+        template<typename RandomAccessIterator>
+        auto break_patterns(RandomAccessIterator begin, RandomAccessIterator pivot_pos,
+                            RandomAccessIterator end)
+            -> void
+        {
+            using utility::iter_swap;
+            using difference_type = difference_type_t<RandomAccessIterator>;
+
+            difference_type l_size = std::distance(begin, pivot_pos);
+            difference_type r_size = std::distance(pivot_pos + 1, end);
+
+            if (l_size >= insertion_sort_threshold) {
+                iter_swap(begin,             begin + l_size / 4);
+                iter_swap(pivot_pos - 1, pivot_pos - l_size / 4);
+
+                if (l_size > ninther_threshold) {
+                    iter_swap(begin + 1,         begin + (l_size / 4 + 1));
+                    iter_swap(begin + 2,         begin + (l_size / 4 + 2));
+                    iter_swap(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+                    iter_swap(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+                }
+            }
+
+            if (r_size >= insertion_sort_threshold) {
+                iter_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+                iter_swap(end - 1,                   end - r_size / 4);
+
+                if (r_size > ninther_threshold) {
+                    iter_swap(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+                    iter_swap(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+                    iter_swap(end - 2,             end - (1 + r_size / 4));
+                    iter_swap(end - 3,             end - (2 + r_size / 4));
+                }
+            }
+        }
+
 
         template<typename RandomAccessIterator, typename Compare, typename Projection,
                  bool Branchless>
@@ -485,16 +547,7 @@ namespace detail
                 }
 
                 // Choose pivot as median of 3 or pseudomedian of 9.
-                difference_type s2 = size / 2;
-                if (size > ninther_threshold) {
-                    iter_sort3(begin, begin + s2, end - 1, compare, projection);
-                    iter_sort3(begin + 1, begin + (s2 - 1), end - 2, compare, projection);
-                    iter_sort3(begin + 2, begin + (s2 + 1), end - 3, compare, projection);
-                    iter_sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1), compare, projection);
-                    iter_swap(begin, begin + s2);
-                } else {
-                    iter_sort3(begin + s2, begin, end - 1, compare, projection);
-                }
+                choose_pivot(begin, end, compare, projection);
 
                 // If *(begin - 1) is the end of the right partition of a previous partition operation
                 // there is no element in [begin, end) that is smaller than *(begin - 1). Then if our
@@ -527,29 +580,7 @@ namespace detail
                         return;
                     }
 
-                    if (l_size >= insertion_sort_threshold) {
-                        iter_swap(begin,             begin + l_size / 4);
-                        iter_swap(pivot_pos - 1, pivot_pos - l_size / 4);
-
-                        if (l_size > ninther_threshold) {
-                            iter_swap(begin + 1,         begin + (l_size / 4 + 1));
-                            iter_swap(begin + 2,         begin + (l_size / 4 + 2));
-                            iter_swap(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
-                            iter_swap(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
-                        }
-                    }
-
-                    if (r_size >= insertion_sort_threshold) {
-                        iter_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
-                        iter_swap(end - 1,                   end - r_size / 4);
-
-                        if (r_size > ninther_threshold) {
-                            iter_swap(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
-                            iter_swap(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
-                            iter_swap(end - 2,             end - (1 + r_size / 4));
-                            iter_swap(end - 3,             end - (2 + r_size / 4));
-                        }
-                    }
+                    break_patterns(begin, pivot_pos, end);
                 } else {
                     // If we were decently balanced and we tried to sort an already partitioned
                     // sequence try to use insertion sort.
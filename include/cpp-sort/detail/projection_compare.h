@@ -30,6 +30,7 @@
 #include <tuple>
 #include <utility>
 #include <cpp-sort/utility/as_function.h>
+#include "type_traits.h"
 
 namespace cppsort
 {
@@ -40,8 +41,10 @@ namespace detail
     {
         private:
 
-            using compare_t = decltype(utility::as_function(std::declval<Compare&>()));
-            using projection_t = decltype(utility::as_function(std::declval<Projection&>()));
+            // Store the function objects by value: as_function returns
+            // references to its parameters for most callables
+            using compare_t = remove_cvref_t<decltype(utility::as_function(std::declval<Compare&>()))>;
+            using projection_t = remove_cvref_t<decltype(utility::as_function(std::declval<Projection&>()))>;
             std::tuple<compare_t, projection_t> data;
 
         public:
@@ -0,0 +1,477 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_DETAIL_QUADSORT_H_
+#define CPPSORT_DETAIL_QUADSORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/utility/as_function.h>
+#include "branchless_merge.h"
+#include "inplace_merge.h"
+#include "insertion_sort.h"
+#include "iterator_traits.h"
+#include "lower_bound.h"
+#include "merge_move.h"
+#include "move.h"
+#include "reverse.h"
+#include "rotate.h"
+#include "simd_merge.h"
+#include "swap_if.h"
+#include "type_traits.h"
+#include "upper_bound.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    // Size of the blocks sorted before the merge phase, the
+    // blocks are merged within the buffer when it is big enough
+    constexpr int quadsort_block_size = 32;
+
+    ////////////////////////////////////////////////////////////
+    // Merge primitives: the branchless versions are used when
+    // the elements are cheap to copy and compare, the other
+    // ones move the elements around
+
+    // Merge [first1, first1 + len1) and [first2, first2 + len2)
+    // into the range starting at result, which must not overlap
+    // with either of the input ranges
+    template<typename RandomAccessIterator1, typename RandomAccessIterator2,
+             typename RandomAccessIterator3, typename Compare, typename Projection>
+    auto quadsort_merge_into(RandomAccessIterator1 first1,
+                             difference_type_t<RandomAccessIterator1> len1,
+                             RandomAccessIterator2 first2,
+                             difference_type_t<RandomAccessIterator2> len2,
+                             RandomAccessIterator3 result,
+                             Compare compare, Projection projection,
+                             std::true_type /* branchless */)
+        -> void
+    {
+        parity_merge(first1, len1, first2, len2, result,
+                     std::move(compare), std::move(projection));
+    }
+
+    template<typename RandomAccessIterator1, typename RandomAccessIterator2,
+             typename RandomAccessIterator3, typename Compare, typename Projection>
+    auto quadsort_merge_into(RandomAccessIterator1 first1,
+                             difference_type_t<RandomAccessIterator1> len1,
+                             RandomAccessIterator2 first2,
+                             difference_type_t<RandomAccessIterator2> len2,
+                             RandomAccessIterator3 result,
+                             Compare compare, Projection projection,
+                             std::false_type /* branchless */)
+        -> void
+    {
+        merge_move(first1, first1 + len1, first2, first2 + len2, result,
+                   std::move(compare), projection, projection);
+    }
+
+    // Merge the buffered run [first1, first1 + len1) with the run
+    // [first2, first2 + len2), result + len1 must be first2
+    template<typename BufferIterator, typename RandomAccessIterator,
+             typename Compare, typename Projection>
+    auto quadsort_half_merge(BufferIterator first1,
+                             difference_type_t<RandomAccessIterator> len1,
+                             RandomAccessIterator first2,
+                             difference_type_t<RandomAccessIterator> len2,
+                             RandomAccessIterator result,
+                             Compare compare, Projection projection,
+                             std::true_type /* branchless */)
+        -> void
+    {
+        auto&& comp = utility::as_function(compare);
+        auto&& proj = utility::as_function(projection);
+
+        auto last1 = first1 + len1;
+        auto last2 = first2 + len2;
+        while (len1 > 0 && len2 > 0) {
+            // The output can't catch up with the second run
+            // as long as the buffer holds elements
+            for (auto count = std::min(len1, len2) ; count > 0 ; --count) {
+                auto value1 = *first1;
+                auto value2 = *first2;
+                bool take_second = comp(proj(value2), proj(value1));
+                *result = take_second ? value2 : value1;
+                ++result;
+                first2 += take_second;
+                first1 += not take_second;
+            }
+            len1 = last1 - first1;
+            len2 = last2 - first2;
+        }
+        // The elements of the second run are already in place
+        detail::move(first1, last1, result);
+    }
+
+    template<typename BufferIterator, typename RandomAccessIterator,
+             typename Compare, typename Projection>
+    auto quadsort_half_merge(BufferIterator first1,
+                             difference_type_t<RandomAccessIterator> len1,
+                             RandomAccessIterator first2,
+                             difference_type_t<RandomAccessIterator> len2,
+                             RandomAccessIterator result,
+                             Compare compare, Projection projection,
+                             std::false_type /* branchless */)
+        -> void
+    {
+        half_inplace_merge(first1, first1 + len1, first2, first2 + len2,
+                           result, std::min(len1, len2),
+                           std::move(compare), std::move(projection));
+    }
+
+    // Vectorized merge of [first, middle) and [middle, last),
+    // only used when the buffer is a plain pointer
+    template<typename RandomAccessIterator, typename T,
+             typename Compare, typename Projection>
+    auto quadsort_simd_merge(RandomAccessIterator first, RandomAccessIterator middle,
+                             RandomAccessIterator last, T* buffer,
+                             Compare compare, Projection projection)
+        -> void
+    {
+        simd_inplace_merge(std::move(first), std::move(middle), std::move(last),
+                           buffer, std::move(compare), std::move(projection));
+    }
+
+    template<typename RandomAccessIterator, typename BufferIterator,
+             typename Compare, typename Projection>
+    auto quadsort_simd_merge(RandomAccessIterator first, RandomAccessIterator middle,
+                             RandomAccessIterator last, BufferIterator buffer,
+                             Compare compare, Projection projection)
+        -> void
+    {
+        detail::move(first, middle, buffer);
+        quadsort_half_merge(buffer, middle - first, middle, last - middle, first,
+                            std::move(compare), std::move(projection),
+                            std::true_type{});
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Merge two runs into result, or move them if they are
+    // already in order; the second run may be empty
+
+    template<typename RandomAccessIterator1, typename RandomAccessIterator2,
+             typename Compare, typename Projection, typename Branchless>
+    auto quadsort_merge_or_move(RandomAccessIterator1 first,
+                                difference_type_t<RandomAccessIterator1> len1,
+                                difference_type_t<RandomAccessIterator1> len2,
+                                RandomAccessIterator2 result,
+                                Compare compare, Projection projection,
+                                Branchless branchless)
+        -> void
+    {
+        auto&& comp = utility::as_function(compare);
+        auto&& proj = utility::as_function(projection);
+
+        auto middle = first + len1;
+        if (len2 == 0 || not comp(proj(*middle), proj(*std::prev(middle)))) {
+            detail::move(first, middle + len2, result);
+            return;
+        }
+        quadsort_merge_into(first, len1, middle, len2, result,
+                            std::move(compare), std::move(projection),
+                            branchless);
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Merge [first, middle) and [middle, last) in place, using
+    // the buffer when one of the runs fits in it, and falling
+    // back to rotations otherwise
+
+    template<typename RandomAccessIterator, typename BufferIterator,
+             typename Compare, typename Projection, typename Branchless>
+    auto quadsort_merge_runs(RandomAccessIterator first, RandomAccessIterator middle,
+                             RandomAccessIterator last,
+                             BufferIterator buffer,
+                             difference_type_t<RandomAccessIterator> buffer_size,
+                             Compare compare, Projection projection,
+                             Branchless branchless)
+        -> void
+    {
+        auto&& comp = utility::as_function(compare);
+        auto&& proj = utility::as_function(projection);
+
+        if (first == middle || middle == last) return;
+
+        // Runs already in order
+        if (not comp(proj(*middle), proj(*std::prev(middle)))) return;
+
+        // Runs in reverse order, rotating them is stable
+        if (comp(proj(*std::prev(last)), proj(*first))) {
+            detail::rotate(first, middle, last);
+            return;
+        }
+
+        // Leave out the elements already in their final place
+        {
+            decltype(auto) middle_value = *middle;
+            first = upper_bound(first, middle, proj(middle_value), compare, projection);
+        }
+        {
+            decltype(auto) last_value = *std::prev(middle);
+            last = lower_bound(middle, last, proj(last_value), compare, projection);
+        }
+        auto len1 = middle - first;
+        auto len2 = last - middle;
+
+        if (len1 <= buffer_size) {
+            if (is_simd_merge_available<RandomAccessIterator, Compare, Projection>()) {
+                quadsort_simd_merge(first, middle, last, buffer, compare, projection);
+                return;
+            }
+            detail::move(first, middle, buffer);
+            quadsort_half_merge(buffer, len1, middle, len2, first,
+                                std::move(compare), std::move(projection),
+                                branchless);
+            return;
+        }
+
+        if (len2 <= buffer_size) {
+            // Merge from the back with reverse iterators
+            detail::move(middle, last, buffer);
+            using RBi = std::reverse_iterator<RandomAccessIterator>;
+            using Rv = std::reverse_iterator<BufferIterator>;
+            half_inplace_merge(Rv(buffer + len2), Rv(buffer),
+                               RBi(middle), RBi(first),
+                               RBi(last), len2,
+                               invert<Compare>(compare), std::move(projection));
+            return;
+        }
+
+        // Neither run fits in the buffer: split the longest run,
+        // rotate the middle parts and merge both sides recursively
+        RandomAccessIterator cut1, cut2;
+        if (len1 >= len2) {
+            cut1 = first + len1 / 2;
+            decltype(auto) cut_value = *cut1;
+            cut2 = lower_bound(middle, last, proj(cut_value), compare, projection);
+        } else {
+            cut2 = middle + len2 / 2;
+            decltype(auto) cut_value = *cut2;
+            cut1 = upper_bound(first, middle, proj(cut_value), compare, projection);
+        }
+        auto new_middle = detail::rotate(cut1, middle, cut2);
+        quadsort_merge_runs(first, cut1, new_middle, buffer, buffer_size,
+                            compare, projection, branchless);
+        quadsort_merge_runs(new_middle, cut2, last, buffer, buffer_size,
+                            std::move(compare), std::move(projection), branchless);
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Merge up to four consecutive runs of the given width with
+    // the buffer, which must be able to hold the whole range
+
+    template<typename RandomAccessIterator, typename BufferIterator,
+             typename Compare, typename Projection, typename Branchless>
+    auto quadsort_quad_merge(RandomAccessIterator first,
+                             difference_type_t<RandomAccessIterator> size,
+                             difference_type_t<RandomAccessIterator> width,
+                             BufferIterator buffer,
+                             Compare compare, Projection projection,
+                             Branchless branchless)
+        -> void
+    {
+        auto&& comp = utility::as_function(compare);
+        auto&& proj = utility::as_function(projection);
+
+        auto len_a = std::min(width, size);
+        auto len_b = std::min(width, size - len_a);
+        auto len_c = std::min(width, size - len_a - len_b);
+        auto len_d = size - len_a - len_b - len_c;
+        if (len_b == 0) return;
+
+        auto first_b = first + len_a;
+        auto first_c = first_b + len_b;
+        auto first_d = first_c + len_c;
+        bool ordered_ab = not comp(proj(*first_b), proj(*std::prev(first_b)));
+        bool ordered_bc = len_c == 0 || not comp(proj(*first_c), proj(*std::prev(first_c)));
+        bool ordered_cd = len_d == 0 || not comp(proj(*first_d), proj(*std::prev(first_d)));
+
+        if (ordered_ab && ordered_bc && ordered_cd) return;
+        if (ordered_ab && ordered_cd) {
+            // Only two runs are left, merge them in place
+            quadsort_merge_runs(first, first_c, first + size, buffer, size,
+                                std::move(compare), std::move(projection),
+                                branchless);
+            return;
+        }
+
+        // Merge the runs pairwise into the buffer, then merge
+        // the two resulting runs back into the original range
+        quadsort_merge_or_move(first, len_a, len_b, buffer,
+                               compare, projection, branchless);
+        quadsort_merge_or_move(first_c, len_c, len_d, buffer + (len_a + len_b),
+                               compare, projection, branchless);
+        quadsort_merge_or_move(buffer, len_a + len_b, len_c + len_d, first,
+                               std::move(compare), std::move(projection),
+                               branchless);
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Merge the consecutive runs of the given width of a range
+    // pairwise into another range
+
+    template<typename RandomAccessIterator1, typename RandomAccessIterator2,
+             typename Compare, typename Projection, typename Branchless>
+    auto quadsort_merge_level(RandomAccessIterator1 first,
+                              difference_type_t<RandomAccessIterator1> size,
+                              difference_type_t<RandomAccessIterator1> width,
+                              RandomAccessIterator2 result,
+                              Compare compare, Projection projection,
+                              Branchless branchless)
+        -> void
+    {
+        for (difference_type_t<RandomAccessIterator1> pos = 0 ; pos < size ; pos += 2 * width) {
+            auto len1 = std::min(width, size - pos);
+            auto len2 = std::min(width, size - pos - len1);
+            quadsort_merge_or_move(first + pos, len1, len2, result + pos,
+                                   compare, projection, branchless);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Sort a block of at most quadsort_block_size elements
+
+    template<typename RandomAccessIterator, typename BufferIterator,
+             typename Compare, typename Projection, typename Branchless>
+    auto quadsort_sort_block(RandomAccessIterator first, RandomAccessIterator last,
+                             BufferIterator buffer,
+                             difference_type_t<RandomAccessIterator> buffer_size,
+                             Compare compare, Projection projection,
+                             Branchless branchless)
+        -> void
+    {
+        auto&& comp = utility::as_function(compare);
+        auto&& proj = utility::as_function(projection);
+
+        auto size = last - first;
+        if (size < 2) return;
+
+        // Leave sorted blocks untouched and reverse strictly
+        // descending ones, which keeps the reversal stable
+        auto it = std::next(first);
+        if (comp(proj(*it), proj(*first))) {
+            do {
+                ++it;
+            } while (it != last && comp(proj(*it), proj(*std::prev(it))));
+            if (it == last) {
+                detail::reverse(first, last);
+                return;
+            }
+        } else {
+            do {
+                ++it;
+            } while (it != last && not comp(proj(*it), proj(*std::prev(it))));
+            if (it == last) return;
+        }
+
+        if (size > buffer_size) {
+            insertion_sort(std::move(first), std::move(last),
+                           std::move(compare), std::move(projection));
+            return;
+        }
+
+        // Sort pairs of elements, then merge runs of increasing
+        // width, alternating between the block and the buffer
+        for (it = first ; last - it > 1 ; it += 2) {
+            iter_swap_if(it, std::next(it), compare, projection);
+        }
+
+        bool in_buffer = false;
+        for (difference_type_t<RandomAccessIterator> width = 2 ; width < size ; width *= 2) {
+            if (in_buffer) {
+                quadsort_merge_level(buffer, size, width, first,
+                                     compare, projection, branchless);
+            } else {
+                quadsort_merge_level(first, size, width, buffer,
+                                     compare, projection, branchless);
+            }
+            in_buffer = not in_buffer;
+        }
+        if (in_buffer) {
+            detail::move(buffer, buffer + size, first);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Stable hybrid merge sort inspired by quadsort: small blocks
+    // are sorted with merges ping-ponging between the collection
+    // and the buffer, then the blocks are merged four at a time
+    // while the buffer is big enough and two at a time otherwise;
+    // the vectorized merge is preferred whenever it is available
+
+    template<typename BufferProvider, typename RandomAccessIterator,
+             typename Compare, typename Projection>
+    auto quadsort(RandomAccessIterator first, RandomAccessIterator last,
+                  Compare compare, Projection projection)
+        -> void
+    {
+        using rvalue_reference = remove_cvref_t<rvalue_reference_t<RandomAccessIterator>>;
+        using difference_type = difference_type_t<RandomAccessIterator>;
+        using branchless = can_merge_branchless<RandomAccessIterator, Compare, Projection>;
+
+        auto size = last - first;
+        if (size < 2) return;
+
+        typename BufferProvider::template buffer<rvalue_reference> buffer(size);
+        auto buffer_size = static_cast<difference_type>(buffer.size());
+
+        // Sort the blocks
+        auto block_first = first;
+        while (last - block_first > quadsort_block_size) {
+            quadsort_sort_block(block_first, block_first + quadsort_block_size,
+                                buffer.begin(), buffer_size,
+                                compare, projection, branchless{});
+            block_first += quadsort_block_size;
+        }
+        quadsort_sort_block(block_first, last, buffer.begin(), buffer_size,
+                            compare, projection, branchless{});
+
+        // Merge the sorted blocks
+        bool simd = is_simd_merge_available<RandomAccessIterator, Compare, Projection>();
+        for (difference_type width = quadsort_block_size ; width < size ;) {
+            if (not simd && std::min(4 * width, size) <= buffer_size) {
+                for (difference_type pos = 0 ; pos < size ; pos += 4 * width) {
+                    quadsort_quad_merge(first + pos, std::min(4 * width, size - pos), width,
+                                        buffer.begin(), compare, projection, branchless{});
+                }
+                width *= 4;
+            } else {
+                for (difference_type pos = 0 ; size - pos > width ; pos += 2 * width) {
+                    quadsort_merge_runs(first + pos, first + (pos + width),
+                                        first + (pos + std::min(2 * width, size - pos)),
+                                        buffer.begin(), buffer_size,
+                                        compare, projection, branchless{});
+                }
+                width *= 2;
+            }
+        }
+    }
+}}
+
+#endif // CPPSORT_DETAIL_QUADSORT_H_
@@ -127,7 +127,8 @@ namespace detail
         internal_mergesort(middle, last, size - size_left, buffer, compare, projection);
 
         // Reduce left partition even more if possible
-        auto&& mid_value = proj(*middle);
+        decltype(auto) middle_value = *middle;
+        auto&& mid_value = proj(middle_value);
         while (first != middle && not comp(mid_value, proj(*first))) {
             ++first;
             --size_left;
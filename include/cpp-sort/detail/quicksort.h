@@ -27,6 +27,7 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <algorithm>
 #include <iterator>
 #include <utility>
 #include <cpp-sort/utility/as_function.h>
@@ -89,9 +90,6 @@ namespace detail
         bool sorted = quicksort_fallback(first, last, size, compare, projection, category{});
         if (sorted) return;
 
-        auto&& comp = utility::as_function(compare);
-        auto&& proj = utility::as_function(projection);
-
         // Choose pivot as either median of 9 or median of medians
         auto temp = pick_pivot(first, last, size, bad_allowed, compare, projection);
         auto median_it = temp.first;
@@ -99,19 +97,9 @@ namespace detail
 
         // Put the pivot at position std::prev(last) and partition
         iter_swap(median_it, last_1);
-        auto&& pivot1 = proj(*last_1);
-        ForwardIterator middle1 = detail::partition(
-            first, last_1,
-            [&](const auto& elem) { return comp(proj(elem), pivot1); }
-        );
-
-        // Put the pivot in its final position and partition
-        iter_swap(middle1, last_1);
-        auto&& pivot2 = proj(*middle1);
-        ForwardIterator middle2 = detail::partition(
-            std::next(middle1), last,
-            [&](const auto& elem) { return not comp(pivot2, proj(elem)); }
-        );
+        auto middles = pivot_partition(first, last_1, last, compare, projection);
+        ForwardIterator middle1 = middles.first;
+        ForwardIterator middle2 = middles.second;
 
         // Recursive call: heuristic trick here: in real world cases,
         // the middle partition is more likely to be smaller than the
@@ -134,6 +122,186 @@ namespace detail
                   std::move(compare), std::move(projection));
     }
 
+    namespace quicksort_detail
+    {
+        enum
+        {
+            // Number of elements classified at once by the block
+            // partitioning, small enough for the offsets to fit in
+            // an unsigned char
+            block_size = 64
+        };
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Dual-pivot partitioning with blocks: given two pivots p1
+    // and p2 in *first and *std::prev(last), partitions the
+    // elements between them as [< p1][p1 <= x <= p2][> p2]
+    //
+    // It is a Lomuto partitioning scheme: elements are classified
+    // block by block without branches, the offsets of the elements
+    // not greater than p2 are recorded and these elements are moved
+    // to the end of the middle partition, then the same is done for
+    // the elements smaller than p1 among the ones that were just
+    // moved; every element is read once, which makes it friendlier
+    // to caches than a two-pass three-way partitioning
+
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    auto dual_pivot_partition(RandomAccessIterator first, RandomAccessIterator last,
+                              Compare compare, Projection projection)
+        -> std::pair<RandomAccessIterator, RandomAccessIterator>
+    {
+        using utility::iter_swap;
+        using difference_type = difference_type_t<RandomAccessIterator>;
+        constexpr difference_type block_size = quicksort_detail::block_size;
+
+        auto&& comp = utility::as_function(compare);
+        auto&& proj = utility::as_function(projection);
+
+        auto last_1 = std::prev(last);
+        decltype(auto) pivot1_value = *first;
+        auto&& pivot1 = proj(pivot1_value);
+        decltype(auto) pivot2_value = *last_1;
+        auto&& pivot2 = proj(pivot2_value);
+
+        unsigned char offsets[block_size];
+        auto less_end = std::next(first);
+        auto middle_end = less_end;
+        for (auto it = less_end ; it != last_1 ;) {
+            auto block = std::min(block_size, last_1 - it);
+
+            // Move the elements not greater than p2 to the
+            // end of the middle partition
+            int num = 0;
+            for (int i = 0 ; i < block ; ++i) {
+                offsets[num] = static_cast<unsigned char>(i);
+                num += not comp(pivot2, proj(it[i]));
+            }
+            auto moved = middle_end;
+            for (int i = 0 ; i < num ; ++i) {
+                iter_swap(middle_end, it + offsets[i]);
+                ++middle_end;
+            }
+
+            // Move the elements smaller than p1 among them to
+            // the end of the left partition
+            int num_less = 0;
+            for (int i = 0 ; i < num ; ++i) {
+                offsets[num_less] = static_cast<unsigned char>(i);
+                num_less += comp(proj(moved[i]), pivot1);
+            }
+            for (int i = 0 ; i < num_less ; ++i) {
+                iter_swap(less_end, moved + offsets[i]);
+                ++less_end;
+            }
+
+            it += block;
+        }
+
+        // Put the pivots in their final positions
+        --less_end;
+        iter_swap(first, less_end);
+        iter_swap(middle_end, last_1);
+        return { less_end, middle_end };
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Dual-pivot quicksort for random-access iterators, falls
+    // back to the single-pivot quicksort above - and thus to the
+    // median of medians - when the recursion gets too deep
+
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    auto dual_pivot_quicksort(RandomAccessIterator first, RandomAccessIterator last,
+                              difference_type_t<RandomAccessIterator> size, int bad_allowed,
+                              Compare compare, Projection projection)
+        -> void
+    {
+        using utility::iter_swap;
+
+        bool sorted = quicksort_fallback(first, last, size, compare, projection,
+                                         std::bidirectional_iterator_tag{});
+        if (sorted) return;
+
+        if (bad_allowed <= 0) {
+            quicksort(std::move(first), std::move(last), size, bad_allowed,
+                      std::move(compare), std::move(projection));
+            return;
+        }
+
+        auto&& comp = utility::as_function(compare);
+        auto&& proj = utility::as_function(projection);
+
+        // Sort 5 equidistant elements and pick the second and
+        // the fourth ones as pivots, then put them at both ends
+        // of the collection
+        auto step = size / 6;
+        for (int i = 0 ; i < 5 ; ++i) {
+            iter_swap(first + i, first + (i + 1) * step);
+        }
+        insertion_sort(first, first + 5, compare, projection);
+        iter_swap(first, first + 1);
+        iter_swap(first + 3, std::prev(last));
+        bool distinct_pivots = comp(proj(*first), proj(*std::prev(last)));
+
+        auto pivots = dual_pivot_partition(first, last, compare, projection);
+        auto pivot1 = pivots.first;
+        auto pivot2 = pivots.second;
+
+        // When the pivots are equal, the middle partition only
+        // contains elements equivalent to them
+        auto middle_first = std::next(pivot1);
+        auto middle_last = pivot2;
+        if (distinct_pivots && middle_last - middle_first > size / 2) {
+            // The middle partition is big, likely because of many
+            // elements equivalent to the pivots: take them out of
+            // the partition before recursing
+            decltype(auto) pivot1_value = *pivot1;
+            auto&& pivot1_proj = proj(pivot1_value);
+            decltype(auto) pivot2_value = *pivot2;
+            auto&& pivot2_proj = proj(pivot2_value);
+            middle_first = detail::partition(
+                middle_first, middle_last,
+                [&](const auto& elem) { return not comp(pivot1_proj, proj(elem)); }
+            );
+            middle_last = detail::partition(
+                middle_first, middle_last,
+                [&](const auto& elem) { return comp(proj(elem), pivot2_proj); }
+            );
+        }
+
+        --bad_allowed;
+        dual_pivot_quicksort(first, pivot1, pivot1 - first, bad_allowed,
+                             compare, projection);
+        if (distinct_pivots) {
+            dual_pivot_quicksort(middle_first, middle_last, middle_last - middle_first,
+                                 bad_allowed, compare, projection);
+        }
+        dual_pivot_quicksort(std::next(pivot2), last, last - std::next(pivot2),
+                             bad_allowed, std::move(compare), std::move(projection));
+    }
+
+    template<typename ForwardIterator, typename Compare, typename Projection>
+    auto quicksort(ForwardIterator first, ForwardIterator last,
+                   difference_type_t<ForwardIterator> size, int bad_allowed,
+                   Compare compare, Projection projection,
+                   std::forward_iterator_tag)
+        -> void
+    {
+        quicksort(std::move(first), std::move(last), size, bad_allowed,
+                  std::move(compare), std::move(projection));
+    }
+
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    auto quicksort(RandomAccessIterator first, RandomAccessIterator last,
+                   difference_type_t<RandomAccessIterator> size, int bad_allowed,
+                   Compare compare, Projection projection,
+                   std::random_access_iterator_tag)
+        -> void
+    {
+        dual_pivot_quicksort(std::move(first), std::move(last), size, bad_allowed,
+                             std::move(compare), std::move(projection));
+    }
+
     template<typename ForwardIterator, typename Compare, typename Projection>
     auto quicksort(ForwardIterator first, ForwardIterator last,
                    difference_type_t<ForwardIterator> size,
@@ -141,7 +309,9 @@ namespace detail
         -> void
     {
         int bad_allowed = 2 * detail::log2(size);  // Usual introsort recursion limit
-        quicksort(first, last, size, bad_allowed, std::move(compare), std::move(projection));
+        using category = iterator_category_t<ForwardIterator>;
+        quicksort(first, last, size, bad_allowed,
+                  std::move(compare), std::move(projection), category{});
     }
 }}
 
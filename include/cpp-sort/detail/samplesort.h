@@ -0,0 +1,95 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_DETAIL_SAMPLESORT_H_
+#define CPPSORT_DETAIL_SAMPLESORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include "ips4o.h"
+#include "iterator_traits.h"
+#include "pdqsort.h"
+#include "type_traits.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // Sequential in-place super scalar samplesort: the core of
+    // IPS4o without the threads, every partitioning pass splits
+    // a range into up to 2^log_buckets buckets instead of two
+
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    auto samplesort(RandomAccessIterator first, RandomAccessIterator last,
+                    Compare compare, Projection projection, int log_buckets,
+                    std::false_type /* copyable keys */)
+        -> void
+    {
+        // The splitters can't be copied out of the collection
+        (void) log_buckets;
+        pdqsort(std::move(first), std::move(last),
+                std::move(compare), std::move(projection));
+    }
+
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    auto samplesort(RandomAccessIterator first, RandomAccessIterator last,
+                    Compare compare, Projection projection, int log_buckets,
+                    std::true_type /* copyable keys */)
+        -> void
+    {
+        using namespace ips4o_detail;
+        using value_type = remove_cvref_t<rvalue_reference_t<RandomAccessIterator>>;
+
+        std::ptrdiff_t size = last - first;
+        if (size <= base_case_size) {
+            pdqsort(std::move(first), std::move(last),
+                    std::move(compare), std::move(projection));
+            return;
+        }
+
+        // Room for the equality buckets too
+        std::ptrdiff_t max_buckets = std::ptrdiff_t(2) << log_buckets_for<value_type>(size, log_buckets);
+        local_data<value_type> local(max_buckets, block_size<value_type>());
+        sequential_sort(std::move(first), std::move(last),
+                        std::move(compare), std::move(projection),
+                        local, log_buckets);
+    }
+
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    auto samplesort(RandomAccessIterator first, RandomAccessIterator last,
+                    Compare compare, Projection projection, int log_buckets)
+        -> void
+    {
+        using key_type = projected_t<RandomAccessIterator, Projection>;
+        samplesort(std::move(first), std::move(last),
+                   std::move(compare), std::move(projection), log_buckets,
+                   std::is_copy_constructible<key_type>{});
+    }
+}}
+
+#endif // CPPSORT_DETAIL_SAMPLESORT_H_
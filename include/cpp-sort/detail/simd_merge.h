@@ -0,0 +1,382 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_DETAIL_SIMD_MERGE_H_
+#define CPPSORT_DETAIL_SIMD_MERGE_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <vector>
+#include <cpp-sort/utility/functional.h>
+#include "config.h"
+#include "iterator_traits.h"
+#include "type_traits.h"
+
+#if CPPSORT_SIMD_X86_DISPATCH
+#   include <immintrin.h>
+#endif
+
+namespace cppsort
+{
+namespace detail
+{
+    //
+    // Merge kernel for two sorted ranges of 32-bit integers
+    // based on a bitonic merge network: two sorted vectors are
+    // merged in registers, the smallest half is stored and the
+    // next vector is loaded from the range whose next element
+    // is the smallest
+    //
+    // The network isn't stable, which is why it is only used
+    // for integers, whose equivalent elements can't be told
+    // apart, and never for floating point numbers where -0.0
+    // and +0.0 are equivalent but distinct. 64-bit integers
+    // are not handled either: without the AVX-512 min and max
+    // instructions the network is slower than a branchless
+    // scalar merge. The AVX2 kernel is selected at runtime
+    // depending on CPU features, other types, comparators and
+    // projections use the scalar merge of the calling algorithm
+    //
+
+    ////////////////////////////////////////////////////////////
+    // Compile-time eligibility
+
+    template<typename T>
+    struct is_simd_mergeable_type:
+        std::integral_constant<
+            bool,
+            std::is_integral<T>::value &&
+            not std::is_same<T, bool>::value &&
+            sizeof(T) == 4
+        >
+    {};
+
+    template<typename Compare, typename T>
+    struct simd_merge_order:
+        std::integral_constant<int, 0>
+    {};
+
+    template<typename T>
+    struct simd_merge_order<std::less<>, T>:
+        std::integral_constant<int, 1>
+    {};
+
+    template<typename T>
+    struct simd_merge_order<std::less<T>, T>:
+        std::integral_constant<int, 1>
+    {};
+
+    template<typename T>
+    struct simd_merge_order<std::greater<>, T>:
+        std::integral_constant<int, -1>
+    {};
+
+    template<typename T>
+    struct simd_merge_order<std::greater<T>, T>:
+        std::integral_constant<int, -1>
+    {};
+
+    // Iterators known to point to contiguous memory, only
+    // checked for the element types handled by the kernel
+
+    template<
+        typename Iterator,
+        bool = is_simd_mergeable_type<value_type_t<Iterator>>::value
+    >
+    struct is_simd_contiguous_iterator:
+        std::false_type
+    {};
+
+    template<typename Iterator>
+    struct is_simd_contiguous_iterator<Iterator, true>:
+        disjunction<
+            std::is_pointer<Iterator>,
+            std::is_same<Iterator, typename std::vector<value_type_t<Iterator>>::iterator>
+        >
+    {};
+
+    template<typename Iterator, typename Compare, typename Projection>
+    struct can_simd_merge:
+        std::integral_constant<
+            bool,
+            CPPSORT_SIMD_X86_DISPATCH &&
+            is_simd_contiguous_iterator<Iterator>::value &&
+            simd_merge_order<remove_cvref_t<Compare>, value_type_t<Iterator>>::value != 0 &&
+            std::is_same<remove_cvref_t<Projection>, utility::identity>::value
+        >
+    {};
+
+#if CPPSORT_SIMD_X86_DISPATCH
+
+    ////////////////////////////////////////////////////////////
+    // Runtime CPU features detection
+
+    inline auto has_avx2()
+        -> bool
+    {
+        static const bool result = (__builtin_cpu_init(), __builtin_cpu_supports("avx2") != 0);
+        return result;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // AVX2 primitives
+
+#   define CPPSORT_TARGET_AVX2 __attribute__((target("avx2")))
+
+    template<bool Signed>
+    struct avx2_minmax;
+
+    template<>
+    struct avx2_minmax<true>
+    {
+        CPPSORT_TARGET_AVX2
+        static auto min(__m256i lhs, __m256i rhs) -> __m256i { return _mm256_min_epi32(lhs, rhs); }
+
+        CPPSORT_TARGET_AVX2
+        static auto max(__m256i lhs, __m256i rhs) -> __m256i { return _mm256_max_epi32(lhs, rhs); }
+    };
+
+    template<>
+    struct avx2_minmax<false>
+    {
+        CPPSORT_TARGET_AVX2
+        static auto min(__m256i lhs, __m256i rhs) -> __m256i { return _mm256_min_epu32(lhs, rhs); }
+
+        CPPSORT_TARGET_AVX2
+        static auto max(__m256i lhs, __m256i rhs) -> __m256i { return _mm256_max_epu32(lhs, rhs); }
+    };
+
+    template<typename T, bool Ascending>
+    struct avx2_bitonic
+    {
+        using minmax = avx2_minmax<std::is_signed<T>::value>;
+
+        // Number of elements per vector
+        static constexpr std::ptrdiff_t size = 8;
+
+        CPPSORT_TARGET_AVX2
+        static auto low(__m256i lhs, __m256i rhs) -> __m256i
+        {
+            return Ascending ? minmax::min(lhs, rhs) : minmax::max(lhs, rhs);
+        }
+
+        CPPSORT_TARGET_AVX2
+        static auto high(__m256i lhs, __m256i rhs) -> __m256i
+        {
+            return Ascending ? minmax::max(lhs, rhs) : minmax::min(lhs, rhs);
+        }
+
+        CPPSORT_TARGET_AVX2
+        static auto xor_indices(int mask) -> __m256i
+        {
+            return _mm256_setr_epi32(0 ^ mask, 1 ^ mask, 2 ^ mask, 3 ^ mask,
+                                     4 ^ mask, 5 ^ mask, 6 ^ mask, 7 ^ mask);
+        }
+
+        CPPSORT_TARGET_AVX2
+        static auto and_mask(int mask) -> __m256i
+        {
+            return _mm256_setr_epi32(-((0 & mask) != 0), -((1 & mask) != 0),
+                                     -((2 & mask) != 0), -((3 & mask) != 0),
+                                     -((4 & mask) != 0), -((5 & mask) != 0),
+                                     -((6 & mask) != 0), -((7 & mask) != 0));
+        }
+
+        // Compare-exchange the lanes distant of dist, the lane
+        // with the lowest index gets the lowest element
+        CPPSORT_TARGET_AVX2
+        static auto exchange(__m256i vec, int dist) -> __m256i
+        {
+            __m256i other = _mm256_permutevar8x32_epi32(vec, xor_indices(dist));
+            return _mm256_blendv_epi8(low(vec, other), high(vec, other), and_mask(dist));
+        }
+
+        // Merge two sorted vectors, lhs gets the lowest half and
+        // rhs gets the highest one, both sorted
+        CPPSORT_TARGET_AVX2
+        static auto merge(__m256i& lhs, __m256i& rhs) -> void
+        {
+            // Reversing rhs makes the concatenation bitonic
+            rhs = _mm256_permutevar8x32_epi32(rhs, xor_indices(7));
+            __m256i lo = low(lhs, rhs);
+            __m256i hi = high(lhs, rhs);
+            lo = exchange(lo, 4);
+            hi = exchange(hi, 4);
+            lo = exchange(lo, 2);
+            hi = exchange(hi, 2);
+            lo = exchange(lo, 1);
+            hi = exchange(hi, 1);
+            lhs = lo;
+            rhs = hi;
+        }
+
+        static auto before(T lhs, T rhs) -> bool
+        {
+            return Ascending ? lhs < rhs : rhs < lhs;
+        }
+
+        // Merge [first1, last1) and [first2, last2) into out, the
+        // output can overlap with the beginning of the second range
+        // as long as it precedes it by at least the size of the
+        // first one, which is what happens when merging in-place
+        CPPSORT_TARGET_AVX2
+        static auto merge(const T* first1, const T* last1,
+                          const T* first2, const T* last2,
+                          T* out)
+            -> void
+        {
+            T carry[size];
+            const T* carry_first = carry;
+            const T* carry_last = carry;
+
+            if (last1 - first1 >= size && last2 - first2 >= size) {
+                __m256i lhs = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first1));
+                __m256i rhs = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first2));
+                first1 += size;
+                first2 += size;
+
+                while (true) {
+                    merge(lhs, rhs);
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), lhs);
+                    out += size;
+
+                    // Load the next vector from the range with the smallest
+                    // head, stop when that range doesn't have enough elements;
+                    // the choice is unpredictable so it is made without branches
+                    bool take_first;
+                    if (first1 == last1) {
+                        take_first = false;
+                    } else if (first2 == last2) {
+                        take_first = true;
+                    } else {
+                        take_first = not before(*first2, *first1);
+                    }
+                    const T* next = take_first ? first1 : first2;
+                    const T* next_last = take_first ? last1 : last2;
+                    if (next_last - next < size) {
+                        break;
+                    }
+                    lhs = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(next));
+                    first1 += take_first * size;
+                    first2 += (not take_first) * size;
+                }
+
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(carry), rhs);
+                carry_last = carry + size;
+            }
+
+            // Merge what remains of the three sorted sequences
+            while (carry_first != carry_last && first1 != last1 && first2 != last2) {
+                const T*& head1 = before(*first2, *first1) ? first2 : first1;
+                const T*& head = before(*carry_first, *head1) ? carry_first : head1;
+                *out++ = *head++;
+            }
+            if (carry_first == carry_last) {
+                carry_first = first1;
+                carry_last = last1;
+            } else if (first1 != last1) {
+                first2 = first1;
+                last2 = last1;
+            }
+            while (carry_first != carry_last && first2 != last2) {
+                const T*& head = before(*first2, *carry_first) ? first2 : carry_first;
+                *out++ = *head++;
+            }
+            out = std::copy(carry_first, carry_last, out);
+            if (out != first2) {
+                std::copy(first2, last2, out);
+            }
+        }
+    };
+
+#   undef CPPSORT_TARGET_AVX2
+
+#endif // CPPSORT_SIMD_X86_DISPATCH
+
+    ////////////////////////////////////////////////////////////
+    // Merge interface
+
+    // Whether the SIMD merge can be used for the given types
+    // on the current machine
+    template<typename Iterator, typename Compare, typename Projection>
+    auto is_simd_merge_available()
+        -> bool
+    {
+#if CPPSORT_SIMD_X86_DISPATCH
+        return can_simd_merge<Iterator, Compare, Projection>::value && has_avx2();
+#else
+        return false;
+#endif
+    }
+
+    template<typename Iterator, typename T>
+    auto simd_inplace_merge_impl(Iterator, Iterator, Iterator, T*, int, std::false_type)
+        -> void
+    {}
+
+#if CPPSORT_SIMD_X86_DISPATCH
+    template<typename Iterator, typename T>
+    auto simd_inplace_merge_impl(Iterator first, Iterator middle, Iterator last,
+                                 T* buffer, int order, std::true_type)
+        -> void
+    {
+        if (first == middle || middle == last) {
+            return;
+        }
+
+        T* first_ptr = std::addressof(*first);
+        T* middle_ptr = first_ptr + (middle - first);
+        T* last_ptr = first_ptr + (last - first);
+        T* buffer_last = std::copy(first_ptr, middle_ptr, buffer);
+
+        if (order > 0) {
+            avx2_bitonic<T, true>::merge(buffer, buffer_last, middle_ptr, last_ptr, first_ptr);
+        } else {
+            avx2_bitonic<T, false>::merge(buffer, buffer_last, middle_ptr, last_ptr, first_ptr);
+        }
+    }
+#endif
+
+    // Merge [first, middle) and [middle, last) in-place, the buffer
+    // must be able to hold at least the elements of [first, middle)
+    // and is_simd_merge_available must have returned true
+    template<typename Iterator, typename T, typename Compare, typename Projection>
+    auto simd_inplace_merge(Iterator first, Iterator middle, Iterator last, T* buffer,
+                            Compare, Projection)
+        -> void
+    {
+        using value_type = value_type_t<Iterator>;
+        simd_inplace_merge_impl(std::move(first), std::move(middle), std::move(last), buffer,
+                                simd_merge_order<remove_cvref_t<Compare>, value_type>::value,
+                                can_simd_merge<Iterator, Compare, Projection>{});
+    }
+}}
+
+#endif // CPPSORT_DETAIL_SIMD_MERGE_H_
@@ -22,9 +22,12 @@
 #include <cpp-sort/utility/as_function.h>
 #include <cpp-sort/utility/functional.h>
 #include "attributes.h"
+#include "bitops.h"
 #include "iterator_traits.h"
 #include "memcpy_cast.h"
+#include "minmax_element.h"
 #include "pdqsort.h"
+#include "total_order_key.h"
 #include "type_traits.h"
 
 namespace cppsort
@@ -71,9 +74,15 @@ namespace detail
     }
 
     inline auto to_unsigned_or_bool(wchar_t c)
-        -> std::uint32_t
+        -> std::make_unsigned_t<wchar_t>
     {
-        return static_cast<std::uint32_t>(c);
+        // Same order as std::char_traits<wchar_t>, which compares
+        // code units as wchar_t whether it is signed or not
+        using unsigned_type = std::make_unsigned_t<wchar_t>;
+        constexpr unsigned_type sign_flip = std::is_signed<wchar_t>::value ?
+            static_cast<unsigned_type>(unsigned_type(1) << (std::numeric_limits<unsigned_type>::digits - 1)) :
+            unsigned_type(0);
+        return static_cast<unsigned_type>(c) ^ sign_flip;
     }
 
     inline auto to_unsigned_or_bool(short i)
@@ -979,6 +988,35 @@ namespace detail
                                               std::move(projection));
     }
 
+    template<typename RandomAccessIterator, typename KeyProjection>
+    auto ska_sort_ranged_keys(RandomAccessIterator begin, RandomAccessIterator end,
+                              KeyProjection key_projection)
+        -> void
+    {
+        // Sort unsigned integer keys, skipping the high bytes that
+        // are the same for every key once the smallest key has been
+        // subtracted: keys in a narrow window such as timestamps or
+        // identifiers otherwise cost a full counting pass per byte
+        // before ska_sort reaches the bytes that differ
+        using key_type = remove_cvref_t<decltype(key_projection(*begin))>;
+        if (end - begin < 2) return;
+
+        auto bounds = minmax_key(begin, end, key_projection);
+        auto range = static_cast<key_type>(bounds.second - bounds.first);
+        if (range == 0) return;
+
+        int shift = std::numeric_limits<key_type>::digits - 1 - static_cast<int>(detail::log2(range));
+        if (shift < 8) {
+            // The highest byte already varies
+            ska_sort(std::move(begin), std::move(end), std::move(key_projection));
+            return;
+        }
+        ska_sort(std::move(begin), std::move(end),
+                 rebased_key_projection<KeyProjection, key_type>{
+                     std::move(key_projection), bounds.first, shift
+                 });
+    }
+
     ////////////////////////////////////////////////////////////
     // Whether a type is sortable with ska_sort
 
@@ -21,6 +21,7 @@ Phil Endecott and Frank Gennari
 // Headers
 ////////////////////////////////////////////////////////////
 #include <algorithm>
+#include <climits>
 #include <cstddef>
 #include <cstring>
 #include <iterator>
@@ -41,6 +42,79 @@ namespace spreadsort
   namespace detail {
     static constexpr int max_step_size = 64;
 
+    //Code units compared the same way the standard strings compare them:
+    //char as unsigned char, wider character types with their own sign
+    template<typename CharT>
+    auto code_unit_key(CharT c)
+        -> std::make_unsigned_t<CharT>
+    {
+      using unsigned_type = std::make_unsigned_t<CharT>;
+      constexpr unsigned_type sign_flip = std::is_signed<CharT>::value ?
+          static_cast<unsigned_type>(unsigned_type(1) << (sizeof(CharT) * CHAR_BIT - 1)) :
+          unsigned_type(0);
+      return static_cast<unsigned_type>(c) ^ sign_flip;
+    }
+
+    inline auto code_unit_key(char c)
+        -> unsigned char
+    {
+      return static_cast<unsigned char>(c);
+    }
+
+    template<typename String>
+    using code_unit_t = std::decay_t<decltype(std::declval<const String&>()[0])>;
+
+    //Strings are sorted one Unsigned_char_type digit at a time: code units
+    //wider than a digit are split into several digits, the most significant
+    //one first, which gives the code unit order regardless of endianness
+    template<typename Unsigned_char_type, typename String>
+    struct digits_per_code_unit:
+      std::integral_constant<
+        std::size_t,
+        sizeof(code_unit_t<String>) / sizeof(Unsigned_char_type)
+      >
+    {
+      static_assert(sizeof(code_unit_t<String>) % sizeof(Unsigned_char_type) == 0,
+                    "code units must be made of a whole number of digits");
+    };
+
+    template<typename Unsigned_char_type, typename String>
+    auto digit_count(const String& str)
+        -> std::size_t
+    {
+      return str.size() * digits_per_code_unit<Unsigned_char_type, String>::value;
+    }
+
+    template<typename Unsigned_char_type, typename String>
+    auto digit_at(const String& str, std::size_t index)
+        -> Unsigned_char_type
+    {
+      constexpr std::size_t per_unit = digits_per_code_unit<Unsigned_char_type, String>::value;
+      constexpr std::size_t digit_bits = sizeof(Unsigned_char_type) * CHAR_BIT;
+      auto unit = code_unit_key(str[index / per_unit]);
+      return static_cast<Unsigned_char_type>(
+        unit >> ((per_unit - 1 - index % per_unit) * digit_bits)
+      );
+    }
+
+    //Whether count digits starting at offset are the same in both strings
+    template<typename Unsigned_char_type, typename String>
+    auto equal_digits(const String& lhs, const String& rhs,
+                      std::size_t offset, std::size_t count)
+        -> bool
+    {
+      if (digits_per_code_unit<Unsigned_char_type, String>::value == 1) {
+        return std::memcmp(lhs.data() + offset, rhs.data() + offset,
+                           count * sizeof(code_unit_t<String>)) == 0;
+      }
+      for (std::size_t i = offset ; i < offset + count ; ++i) {
+        if (digit_at<Unsigned_char_type>(lhs, i) != digit_at<Unsigned_char_type>(rhs, i)) {
+          return false;
+        }
+      }
+      return true;
+    }
+
     //Offsetting on identical characters.  This function works a chunk of
     //characters at a time for cache efficiency and optimal worst-case
     //performance.
@@ -60,17 +134,16 @@ namespace spreadsort
           //Ignore empties, but if the nextOffset would exceed the length or
           //not match, exit; we've found the last matching character
           //This will reduce the step_size if the current step doesn't match.
-          if (proj(*curr).size() > char_offset) {
-            if(proj(*curr).size() <= (nextOffset + step_size)) {
-              step_size = proj(*curr).size() - nextOffset - 1;
+          if (digit_count<Unsigned_char_type>(proj(*curr)) > char_offset) {
+            if(digit_count<Unsigned_char_type>(proj(*curr)) <= (nextOffset + step_size)) {
+              step_size = digit_count<Unsigned_char_type>(proj(*curr)) - nextOffset - 1;
               if (step_size < 1) {
                 char_offset = nextOffset;
                 return;
               }
             }
-            const int step_byte_size = step_size * char_size;
-            if (std::memcmp(proj(*curr).data() + nextOffset, proj(*first).data() + nextOffset,
-                            step_byte_size) != 0) {
+            if (not equal_digits<Unsigned_char_type>(proj(*curr), proj(*first),
+                                                     nextOffset, step_size)) {
               if (step_size == 1) {
                 char_offset = nextOffset;
                 return;
@@ -99,15 +172,18 @@ namespace spreadsort
         {
             auto&& proj = utility::as_function(std::get<1>(data));
 
+            //The digits before char_offset are the same, so whole code
+            //units can be compared from the one holding char_offset
+            using string_type = std::decay_t<decltype(proj(x))>;
+            constexpr std::size_t per_unit = digits_per_code_unit<Unsigned_char_type, string_type>::value;
             std::size_t minSize = (std::min)(proj(x).size(), proj(y).size());
-            for (std::size_t u = std::get<0>(data) ; u < minSize ; ++u)
+            for (std::size_t u = std::get<0>(data) / per_unit ; u < minSize ; ++u)
             {
-                static_assert(sizeof(proj(x)[u]) == sizeof(Unsigned_char_type), "");
-                if (static_cast<Unsigned_char_type>(proj(x)[u]) !=
-                    static_cast<Unsigned_char_type>(proj(y)[u]))
+                auto x_unit = code_unit_key(proj(x)[u]);
+                auto y_unit = code_unit_key(proj(y)[u]);
+                if (x_unit != y_unit)
                 {
-                    return static_cast<Unsigned_char_type>(proj(x)[u]) <
-                           static_cast<Unsigned_char_type>(proj(y)[u]);
+                    return x_unit < y_unit;
                 }
             }
             return proj(x).size() < proj(y).size();
@@ -131,15 +207,18 @@ namespace spreadsort
         {
             auto&& proj = utility::as_function(std::get<1>(data));
 
+            //The digits before char_offset are the same, so whole code
+            //units can be compared from the one holding char_offset
+            using string_type = std::decay_t<decltype(proj(x))>;
+            constexpr std::size_t per_unit = digits_per_code_unit<Unsigned_char_type, string_type>::value;
             std::size_t minSize = (std::min)(proj(x).size(), proj(y).size());
-            for (std::size_t u = std::get<0>(data) ; u < minSize ; ++u)
+            for (std::size_t u = std::get<0>(data) / per_unit ; u < minSize ; ++u)
             {
-                static_assert(sizeof(proj(x)[u]) == sizeof(Unsigned_char_type), "");
-                if (static_cast<Unsigned_char_type>(proj(x)[u]) !=
-                    static_cast<Unsigned_char_type>(proj(y)[u]))
+                auto x_unit = code_unit_key(proj(x)[u]);
+                auto y_unit = code_unit_key(proj(y)[u]);
+                if (x_unit != y_unit)
                 {
-                    return static_cast<Unsigned_char_type>(proj(x)[u]) >
-                           static_cast<Unsigned_char_type>(proj(y)[u]);
+                    return x_unit > y_unit;
                 }
             }
             return proj(x).size() > proj(y).size();
@@ -163,13 +242,13 @@ namespace spreadsort
       //This section makes handling of long identical substrings much faster
       //with a mild average performance impact.
       //Iterate to the end of the empties.  If all empty, return
-      while (proj(*first).size() <= char_offset) {
+      while (digit_count<Unsigned_char_type>(proj(*first)) <= char_offset) {
         if (++first == last)
           return;
       }
       RandomAccessIter finish = std::prev(last);
       //Getting the last non-empty
-      for (;proj(*finish).size() <= char_offset; --finish);
+      for (;digit_count<Unsigned_char_type>(proj(*finish)) <= char_offset; --finish);
       ++finish;
       //Offsetting on identical characters.  This section works
       //a few characters at a time for optimal worst-case performance.
@@ -185,11 +264,11 @@ namespace spreadsort
 
       //Calculating the size of each bin; this takes roughly 10% of runtime
       for (RandomAccessIter current = first; current != last; ++current) {
-        if (proj(*current).size() <= char_offset) {
+        if (digit_count<Unsigned_char_type>(proj(*current)) <= char_offset) {
           bin_sizes[0]++;
         }
         else
-          bin_sizes[static_cast<Unsigned_char_type>(proj(*current)[char_offset])
+          bin_sizes[digit_at<Unsigned_char_type>(proj(*current), char_offset)
                     + 1]++;
       }
       //Assign the bin positions
@@ -208,8 +287,8 @@ namespace spreadsort
       for (RandomAccessIter current = *local_bin; current < next_bin_start;
           ++current) {
         //empties belong in this bin
-        while (proj(*current).size() > char_offset) {
-          target_bin = bins + static_cast<Unsigned_char_type>(proj(*current)[char_offset]);
+        while (digit_count<Unsigned_char_type>(proj(*current)) > char_offset) {
+          target_bin = bins + digit_at<Unsigned_char_type>(proj(*current), char_offset);
           iter_swap(current, *target_bin);
           ++(*target_bin);
         }
@@ -227,10 +306,8 @@ namespace spreadsort
         for (RandomAccessIter current = *local_bin; current < next_bin_start;
             ++current) {
           //Swapping into place until the correct element has been swapped in
-          for (target_bin = bins + static_cast<Unsigned_char_type>
-               (proj(*current)[char_offset]); target_bin != local_bin;
-               target_bin = bins + static_cast<Unsigned_char_type>
-               (proj(*current)[char_offset])) {
+          for (target_bin = bins + digit_at<Unsigned_char_type>(proj(*current), char_offset); target_bin != local_bin;
+               target_bin = bins + digit_at<Unsigned_char_type>(proj(*current), char_offset)) {
             iter_swap(current, *target_bin);
             ++(*target_bin);
           }
@@ -274,12 +351,12 @@ namespace spreadsort
       //with a mild average performance impact.
       RandomAccessIter curr = first;
       //Iterate to the end of the empties.  If all empty, return
-      while (proj(*curr).size() <= char_offset) {
+      while (digit_count<Unsigned_char_type>(proj(*curr)) <= char_offset) {
         if (++curr == last)
           return;
       }
       //Getting the last non-empty
-      while (proj(*(--last)).size() <= char_offset);
+      while (digit_count<Unsigned_char_type>(proj(*(--last))) <= char_offset);
       ++last;
       //Offsetting on identical characters.  This section works
       //a few characters at a time for optimal worst-case performance.
@@ -298,12 +375,11 @@ namespace spreadsort
 
       //Calculating the size of each bin; this takes roughly 10% of runtime
       for (RandomAccessIter current = first; current != last; ++current) {
-        if (proj(*current).size() <= char_offset) {
+        if (digit_count<Unsigned_char_type>(proj(*current)) <= char_offset) {
           bin_sizes[bin_count]++;
         }
         else
-          bin_sizes[max_bin - static_cast<Unsigned_char_type>
-            (proj(*current)[char_offset])]++;
+          bin_sizes[max_bin - digit_at<Unsigned_char_type>(proj(*current), char_offset)]++;
       }
       //Assign the bin positions
       bin_cache[cache_offset] = first;
@@ -320,8 +396,8 @@ namespace spreadsort
       for (RandomAccessIter current = *local_bin; current < next_bin_start;
           ++current) {
         //empties belong in this bin
-        while (proj(*current).size() > char_offset) {
-          target_bin = end_bin - static_cast<Unsigned_char_type>(proj(*current)[char_offset]);
+        while (digit_count<Unsigned_char_type>(proj(*current)) > char_offset) {
+          target_bin = end_bin - digit_at<Unsigned_char_type>(proj(*current), char_offset);
           iter_swap(current, *target_bin);
           ++(*target_bin);
         }
@@ -341,10 +417,10 @@ namespace spreadsort
             ++current) {
           //Swapping into place until the correct element has been swapped in
           for (target_bin =
-               end_bin - static_cast<Unsigned_char_type>(proj(*current)[char_offset]);
+               end_bin - digit_at<Unsigned_char_type>(proj(*current), char_offset);
                target_bin != local_bin;
                target_bin =
-               end_bin - static_cast<Unsigned_char_type>(proj(*current)[char_offset])) {
+               end_bin - digit_at<Unsigned_char_type>(proj(*current), char_offset)) {
             iter_swap(current, *target_bin);
             ++(*target_bin);
           }
@@ -0,0 +1,139 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_DETAIL_STRING_KEYS_H_
+#define CPPSORT_DETAIL_STRING_KEYS_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include "config.h"
+#include "iterator_traits.h"
+#include "type_traits.h"
+
+#if __cplusplus > 201402L && __has_include(<string_view>)
+#   include <string_view>
+#endif
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // Whether the projected elements are strings that the string
+    // sorters can refer to by pointer until the end of the sort,
+    // which excludes projections returning std::string by value
+
+    template<typename Iterator, typename Projection>
+    using is_string_key = std::integral_constant<bool,
+        (
+            std::is_same<projected_t<Iterator, Projection>, std::string>::value &&
+            std::is_lvalue_reference<
+                invoke_result_t<Projection, decltype(*std::declval<Iterator&>())>
+            >::value
+        )
+#if __cplusplus > 201402L && __has_include(<string_view>)
+        || std::is_same<projected_t<Iterator, Projection>, std::string_view>::value
+#endif
+    >;
+
+    ////////////////////////////////////////////////////////////
+    // Char of a string key such that comparing the keys as
+    // unsigned bytes, which is what std::string and the radix
+    // sorts do, gives the same results as comparing the original
+    // chars: signed chars get their sign bit flipped
+
+    template<typename CharT>
+    auto unsigned_order_char(CharT c)
+        -> CharT
+    {
+        return c;
+    }
+
+    inline auto unsigned_order_char(char c)
+        -> char
+    {
+        if (std::is_signed<char>::value) {
+            return static_cast<char>(static_cast<unsigned char>(c) ^ 0x80u);
+        }
+        return c;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Bytes of a string key, and index of the string in the
+    // original collection
+
+    struct string_ref
+    {
+        const unsigned char* data;
+        std::size_t size;
+    };
+
+    struct string_entry
+    {
+        string_ref str;
+        std::size_t index;
+    };
+
+    template<typename String>
+    auto make_string_ref(const String& str)
+        -> string_ref
+    {
+        return {
+            reinterpret_cast<const unsigned char*>(str.data()),
+            static_cast<std::size_t>(str.size())
+        };
+    }
+
+    // Whether lhs is smaller than rhs, knowing that their
+    // first depth bytes are equal
+    inline auto suffix_less(const string_ref& lhs, const string_ref& rhs, std::size_t depth)
+        -> bool
+    {
+        auto lhs_size = lhs.size - depth;
+        auto rhs_size = rhs.size - depth;
+        int res = std::memcmp(lhs.data + depth, rhs.data + depth,
+                              lhs_size < rhs_size ? lhs_size : rhs_size);
+        return res != 0 ? res < 0 : lhs_size < rhs_size;
+    }
+
+    // Length of the longest common prefix of two strings, knowing
+    // that their first depth bytes are equal
+    inline auto common_prefix_length(const string_ref& lhs, const string_ref& rhs,
+                                     std::size_t depth)
+        -> std::size_t
+    {
+        std::size_t size = lhs.size < rhs.size ? lhs.size : rhs.size;
+        while (depth < size && lhs.data[depth] == rhs.data[depth]) {
+            ++depth;
+        }
+        return depth;
+    }
+}}
+
+#endif // CPPSORT_DETAIL_STRING_KEYS_H_
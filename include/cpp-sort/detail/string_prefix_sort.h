@@ -0,0 +1,189 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_DETAIL_STRING_PREFIX_SORT_H_
+#define CPPSORT_DETAIL_STRING_PREFIX_SORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <vector>
+#include <cpp-sort/utility/apply_permutation.h>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/functional.h>
+#include "insertion_sort.h"
+#include "pdqsort.h"
+#include "string_keys.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    namespace string_prefix_detail
+    {
+        ////////////////////////////////////////////////////////////
+        // Tuning parameters
+
+        // Number of bytes cached in a prefix
+        constexpr std::size_t prefix_size = sizeof(std::uint64_t);
+
+        // Runs of equal prefixes smaller than this are sorted by
+        // comparing the rest of the strings directly
+        constexpr std::ptrdiff_t small_run_size = 16;
+
+        ////////////////////////////////////////////////////////////
+        // Sort entries caching the bytes of a string at the
+        // current depth next to its index
+
+        struct prefix_entry
+        {
+            std::uint64_t prefix;
+            std::size_t index;
+        };
+
+        // Big-endian load of the bytes [depth, depth + 8) of the
+        // string, padded with zeros: comparing the prefixes gives
+        // the same result as comparing the bytes
+        inline auto load_prefix(const string_ref& str, std::size_t depth)
+            -> std::uint64_t
+        {
+            std::uint64_t res = 0;
+            if (str.size >= depth + prefix_size) {
+                for (std::size_t i = 0 ; i < prefix_size ; ++i) {
+                    res = (res << 8) | str.data[depth + i];
+                }
+            } else {
+                for (std::size_t i = depth ; i < depth + prefix_size ; ++i) {
+                    res = (res << 8) | (i < str.size ? str.data[i] : 0u);
+                }
+            }
+            return res;
+        }
+
+        inline auto sort_prefixes(prefix_entry* first, prefix_entry* last,
+                                  const string_ref* strings, std::size_t depth)
+            -> void;
+
+        // Sort entries whose strings have equal prefixes at depth
+        inline auto sort_ties(prefix_entry* first, prefix_entry* last,
+                              const string_ref* strings, std::size_t depth)
+            -> void
+        {
+            if (last - first < small_run_size) {
+                insertion_sort(first, last, [strings, depth](const auto& lhs, const auto& rhs) {
+                    return suffix_less(strings[lhs.index], strings[rhs.index], depth);
+                }, utility::identity{});
+                return;
+            }
+
+            // The strings ending within the prefix are prefixes of
+            // the longer ones - the padding zeros match the bytes
+            // of the longer strings - so they come first, ordered
+            // by size
+            auto next_depth = depth + prefix_size;
+            auto middle = std::partition(first, last, [&](const prefix_entry& entry) {
+                return strings[entry.index].size <= next_depth;
+            });
+            pdqsort(first, middle, std::less<>{}, [strings](const prefix_entry& entry) {
+                return strings[entry.index].size;
+            });
+
+            // Refresh the prefixes of the longer strings and sort
+            // them at the next depth
+            if (last - middle > 1) {
+                for (auto it = middle ; it != last ; ++it) {
+                    it->prefix = load_prefix(strings[it->index], next_depth);
+                }
+                sort_prefixes(middle, last, strings, next_depth);
+            }
+        }
+
+        // Sort entries whose strings have equal first depth bytes
+        // and whose prefixes were loaded at depth
+        inline auto sort_prefixes(prefix_entry* first, prefix_entry* last,
+                                  const string_ref* strings, std::size_t depth)
+            -> void
+        {
+            // Integer comparisons allow pdqsort to use its
+            // branchless partitioning
+            pdqsort(first, last, std::less<>{}, &prefix_entry::prefix);
+
+            // Only look at the strings when prefixes are equal
+            for (auto run = first ; run != last ;) {
+                auto run_end = std::next(run);
+                while (run_end != last && run_end->prefix == run->prefix) {
+                    ++run_end;
+                }
+                if (run_end - run > 1) {
+                    sort_ties(run, run_end, strings, depth);
+                }
+                run = run_end;
+            }
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Sort strings by sorting their cached prefixes, reordering
+    // the original collection once at the end
+
+    template<typename RandomAccessIterator, typename Projection>
+    auto cached_prefix_sort(RandomAccessIterator first, RandomAccessIterator last,
+                            Projection projection, bool descending)
+        -> void
+    {
+        using namespace string_prefix_detail;
+        auto&& proj = utility::as_function(projection);
+
+        auto size = static_cast<std::size_t>(last - first);
+        if (size < 2) return;
+
+        std::vector<string_ref> strings;
+        std::vector<prefix_entry> entries;
+        strings.reserve(size);
+        entries.reserve(size);
+        for (std::size_t i = 0 ; i < size ; ++i) {
+            strings.push_back(make_string_ref(proj(first[i])));
+            entries.push_back({ load_prefix(strings.back(), 0), i });
+        }
+
+        sort_prefixes(entries.data(), entries.data() + size, strings.data(), 0);
+        if (descending) {
+            std::reverse(entries.begin(), entries.end());
+        }
+
+        // Move the strings to their final positions
+        std::vector<std::size_t> indices;
+        indices.reserve(size);
+        for (const auto& entry: entries) {
+            indices.push_back(entry.index);
+        }
+        utility::apply_permutation(indices.begin(), indices.end(), first);
+    }
+}}
+
+#endif // CPPSORT_DETAIL_STRING_PREFIX_SORT_H_
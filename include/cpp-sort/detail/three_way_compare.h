@@ -29,12 +29,41 @@
 ////////////////////////////////////////////////////////////
 #include <functional>
 #include <string>
+#include <type_traits>
 #include <utility>
+#include "type_traits.h"
 
 namespace cppsort
 {
 namespace detail
 {
+    ////////////////////////////////////////////////////////////
+    // Comparators can provide a three_way(lhs, rhs) member
+    // function whose result is negative, zero or positive when
+    // lhs is respectively smaller than, equivalent to or greater
+    // than rhs, which is then used instead of two comparisons
+
+    template<typename Compare, typename T, typename U>
+    using has_three_way_t = decltype(std::declval<const Compare&>().three_way(
+        std::declval<T>(), std::declval<U>()
+    ));
+
+    template<typename Compare, typename T, typename U>
+    constexpr auto three_way_call(const Compare& compare, T&& lhs, U&& rhs, std::true_type)
+        -> int
+    {
+        auto res = compare.three_way(std::forward<T>(lhs), std::forward<U>(rhs));
+        return (0 < res) - (res < 0);
+    }
+
+    template<typename Compare, typename T, typename U>
+    constexpr auto three_way_call(const Compare& compare, T&& lhs, U&& rhs, std::false_type)
+        -> int
+    {
+        return compare(std::forward<T>(lhs), std::forward<U>(rhs)) ? -1 :
+               compare(std::forward<U>(rhs), std::forward<T>(lhs));
+    }
+
     template<typename Derived>
     struct three_way_compare_base
     {
@@ -45,8 +74,9 @@ namespace detail
                 -> int
             {
                 auto&& compare = derived().base();
-                return compare(std::forward<T>(lhs), std::forward<U>(rhs)) ? -1 :
-                       compare(std::forward<U>(rhs), std::forward<T>(lhs));
+                using compare_t = remove_cvref_t<decltype(compare)>;
+                return three_way_call(compare, std::forward<T>(lhs), std::forward<U>(rhs),
+                                      is_detected<has_three_way_t, compare_t, T, U>{});
             }
 
             template<typename T, typename U>
@@ -60,18 +90,14 @@ namespace detail
             auto le(T&& x, U&& y) const
                 -> decltype(auto)
             {
-                auto&& compare = derived().base();
-                return compare(std::forward<T>(x), std::forward<U>(y))
-                    || not compare(std::forward<U>(y), std::forward<T>(x));
+                return not derived().base()(std::forward<U>(y), std::forward<T>(x));
             }
 
             template<typename T, typename U>
             auto gt(T&& x, U&& y) const
                 -> decltype(auto)
             {
-                auto&& compare = derived().base();
-                return not compare(std::forward<T>(x), std::forward<U>(y))
-                    && compare(std::forward<U>(y), std::forward<T>(x));
+                return derived().base()(std::forward<U>(y), std::forward<T>(x));
             }
 
             template<typename T, typename U>
@@ -171,6 +197,26 @@ namespace detail
             return {};
         }
     };
+    ////////////////////////////////////////////////////////////
+    // Whether a comparator compares values of type T with a
+    // single three-way comparison instead of two comparisons,
+    // algorithms can switch to schemes relying on three-way
+    // comparisons when it is the case
+
+    template<typename Compare, typename T>
+    struct has_three_way_comparison:
+        is_detected<has_three_way_t, Compare, const T&, const T&>
+    {};
+
+    template<typename CharT, typename Traits, typename Alloc>
+    struct has_three_way_comparison<std::less<>, std::basic_string<CharT, Traits, Alloc>>:
+        std::true_type
+    {};
+
+    template<typename CharT, typename Traits, typename Alloc>
+    struct has_three_way_comparison<std::greater<>, std::basic_string<CharT, Traits, Alloc>>:
+        std::true_type
+    {};
 }}
 
 #endif // CPPSORT_DETAIL_THREE_WAY_COMPARE_H_
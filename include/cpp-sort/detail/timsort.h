@@ -34,6 +34,7 @@
 ////////////////////////////////////////////////////////////
 #include <algorithm>
 #include <cassert>
+#include <cstddef>
 #include <iterator>
 #include <memory>
 #include <new>
@@ -47,6 +48,7 @@
 #include "memory.h"
 #include "move.h"
 #include "reverse.h"
+#include "simd_merge.h"
 #include "three_way_compare.h"
 #include "type_traits.h"
 #include "upper_bound.h"
@@ -55,7 +57,8 @@ namespace cppsort
 {
 namespace detail
 {
-    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    template<typename RandomAccessIterator, typename Compare,
+             typename Projection, typename MergePolicy>
     class TimSort
     {
         using iterator = RandomAccessIterator;
@@ -95,6 +98,66 @@ namespace detail
         };
         std::vector<run> pending_;
 
+        // Policy deciding which runs to merge
+        MergePolicy policy_;
+
+        // View over the stack of pending runs passed to the merge
+        // policy, which can only query the runs and merge them
+        class runs_view
+        {
+            public:
+
+                runs_view(TimSort& ts, iterator first, difference_type size):
+                    ts_(ts),
+                    first_(std::move(first)),
+                    size_(size)
+                {}
+
+                auto size() const
+                    -> std::size_t
+                {
+                    return ts_.pending_.size();
+                }
+
+                auto total_length() const
+                    -> difference_type
+                {
+                    return size_;
+                }
+
+                auto offset(std::size_t pos) const
+                    -> difference_type
+                {
+                    return ts_.pending_[pos].base - first_;
+                }
+
+                auto length(std::size_t pos) const
+                    -> difference_type
+                {
+                    return ts_.pending_[pos].len;
+                }
+
+                // Merge the runs at positions pos and pos + 1
+                auto merge_at(std::size_t pos)
+                    -> void
+                {
+                    ts_.mergeAt(pos);
+                }
+
+                // Merge count consecutive runs starting at position pos
+                auto merge_runs(std::size_t pos, std::size_t count)
+                    -> void
+                {
+                    ts_.mergeRuns(pos, count);
+                }
+
+            private:
+
+                TimSort& ts_;
+                iterator first_;
+                difference_type size_;
+        };
+
         static auto sort(iterator const lo, iterator const hi, compare_type c, Projection projection)
             -> void
         {
@@ -112,6 +175,7 @@ namespace detail
             }
 
             TimSort ts(c, projection);
+            runs_view runs(ts, lo, nRemaining);
             difference_type const minRun = minRunLength(nRemaining);
             iterator cur          = lo;
             do {
@@ -124,14 +188,14 @@ namespace detail
                 }
 
                 ts.pushRun(cur, runLen);
-                ts.mergeCollapse();
+                ts.policy_.collapse(runs);
 
                 cur        += runLen;
                 nRemaining -= runLen;
             } while (nRemaining != 0);
 
             assert( cur == hi );
-            ts.mergeForceCollapse();
+            ts.policy_.force_collapse(runs);
             assert( ts.pending_.size() == 1 );
         } // sort()
 
@@ -205,48 +269,11 @@ namespace detail
             pending_.emplace_back(runBase, runLen);
         }
 
-        auto mergeCollapse()
-            -> void
-        {
-            while ( pending_.size() > 1 ) {
-                difference_type n = pending_.size() - 2;
-
-                if ((n > 0 && pending_[n - 1].len <= pending_[n].len + pending_[n + 1].len)
-                    || (n > 1 && pending_[n - 2].len <= pending_[n - 1].len + pending_[n].len)){
-                    if (pending_[n - 1].len < pending_[n + 1].len) {
-                        --n;
-                    }
-                    mergeAt(n);
-                }
-                else if (pending_[n].len <= pending_[n + 1].len) {
-                    mergeAt(n);
-                }
-                else {
-                    break;
-                }
-            }
-        }
-
-        auto mergeForceCollapse()
+        auto mergeAt(std::size_t const i)
             -> void
         {
-            while ( pending_.size() > 1 ) {
-                difference_type n = pending_.size() - 2;
-
-                if (n > 0 && pending_[n - 1].len < pending_[n + 1].len) {
-                    --n;
-                }
-                mergeAt(n);
-            }
-        }
-
-        auto mergeAt(difference_type const i)
-            -> void
-        {
-            difference_type const stackSize = pending_.size();
-            assert( stackSize >= 2 );
-            assert( i >= 0 );
-            assert( i == stackSize - 2 || i == stackSize - 3 );
+            assert( pending_.size() >= 2 );
+            assert( i < pending_.size() - 1 );
 
             iterator base1 = pending_[i].base;
             difference_type len1  = pending_[i].len;
@@ -258,12 +285,7 @@ namespace detail
             assert( base1 + len1 == base2 );
 
             pending_[i].len = len1 + len2;
-
-            if (i == stackSize - 3) {
-                pending_[i + 1] = pending_[i + 2];
-            }
-
-            pending_.pop_back();
+            pending_.erase(pending_.begin() + (i + 1));
 
             difference_type const k = gallopRight(*base2, base1, len1, 0);
             assert( k >= 0 );
@@ -281,6 +303,13 @@ namespace detail
                 return;
             }
 
+            if (is_simd_merge_available<iterator, Compare, Projection>()) {
+                resize_buffer(len1);
+                simd_inplace_merge(base1, base2, base2 + len2, buffer.get(),
+                                   comp_.base(), proj_);
+                return;
+            }
+
             if (len1 <= len2) {
                 mergeLo(base1, len1, base2, len2);
             }
@@ -289,6 +318,70 @@ namespace detail
             }
         }
 
+        auto mergeRuns(std::size_t const i, std::size_t const count)
+            -> void
+        {
+            assert( i + count <= pending_.size() );
+
+            if (count < 2) {
+                return;
+            }
+            if (count == 2) {
+                mergeAt(i);
+                return;
+            }
+
+            using utility::iter_move;
+
+            iterator const base = pending_[i].base;
+            difference_type len = 0;
+            for (std::size_t n = i ; n < i + count ; ++n) {
+                len += pending_[n].len;
+            }
+
+            // Move every run to the buffer, then merge them back
+            resize_buffer(len);
+            destruct_n<rvalue_reference> d(0);
+            std::unique_ptr<rvalue_reference, destruct_n<rvalue_reference>&> h2(buffer.get(), d);
+
+            rvalue_reference* ptr = buffer.get();
+            for (auto it = base ; it != base + len ; ++d, (void) ++it, ++ptr) {
+                ::new(ptr) rvalue_reference(iter_move(it));
+            }
+
+            // Bounds of the runs left to merge in the buffer
+            std::vector<std::pair<rvalue_reference*, rvalue_reference*>> cursors;
+            cursors.reserve(count);
+            ptr = buffer.get();
+            for (std::size_t n = i ; n < i + count ; ++n) {
+                cursors.emplace_back(ptr, ptr + pending_[n].len);
+                ptr += pending_[n].len;
+            }
+
+            auto&& proj = utility::as_function(proj_);
+            iterator dest = base;
+            while (cursors.size() > 1) {
+                // Pick the smallest head, the leftmost run wins
+                // ties to keep the merge stable
+                auto min_it = cursors.begin();
+                for (auto it = std::next(min_it) ; it != cursors.end() ; ++it) {
+                    if (comp_.lt(proj(*it->first), proj(*min_it->first))) {
+                        min_it = it;
+                    }
+                }
+
+                *dest = std::move(*min_it->first);
+                ++dest;
+                if (++min_it->first == min_it->second) {
+                    cursors.erase(min_it);
+                }
+            }
+            detail::move(cursors.front().first, cursors.front().second, dest);
+
+            pending_[i].len = len;
+            pending_.erase(pending_.begin() + (i + 1), pending_.begin() + (i + count));
+        }
+
         template<typename T, typename Iter>
         auto gallopLeft(const T& key, Iter const base, difference_type const len, difference_type const hint)
             -> difference_type
@@ -709,19 +802,20 @@ namespace detail
         }
 
         // the only interface is the friend timsort() function
-        template<typename IterT, typename LessT, typename Proj>
+        template<typename Policy, typename IterT, typename LessT, typename Proj>
         friend void timsort(IterT, IterT, LessT, Proj);
     };
 
-    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    template<typename MergePolicy, typename RandomAccessIterator,
+             typename Compare, typename Projection>
     auto timsort(RandomAccessIterator const first, RandomAccessIterator const last,
                  Compare compare, Projection projection)
         -> void
     {
         using compare_t = remove_cvref_t<decltype(utility::as_function(compare))>;
-        TimSort<RandomAccessIterator, compare_t, Projection>::sort(std::move(first), std::move(last),
-                                                                   utility::as_function(compare),
-                                                                   std::move(projection));
+        using timsort_t = TimSort<RandomAccessIterator, compare_t, Projection, MergePolicy>;
+        timsort_t::sort(std::move(first), std::move(last),
+                        utility::as_function(compare), std::move(projection));
     }
 }}
 
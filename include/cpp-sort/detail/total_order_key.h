@@ -0,0 +1,143 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_DETAIL_TOTAL_ORDER_KEY_H_
+#define CPPSORT_DETAIL_TOTAL_ORDER_KEY_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/utility/as_function.h>
+#include "memcpy_cast.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    //
+    // Unsigned integer keys whose natural order is the order
+    // of total_less: integers get their sign bit flipped, and
+    // IEEE 754 floating point numbers additionally get all of
+    // their other bits flipped when negative, which gives the
+    // totalOrder predicate: negative quiet NaNs, negative
+    // signaling NaNs, negative infinity, negative reals, -0.0,
+    // +0.0, positive reals, positive infinity, then positive
+    // signaling and quiet NaNs, NaNs being further ordered by
+    // payload
+    //
+
+    template<typename T>
+    struct has_total_order_key:
+        std::integral_constant<
+            bool,
+            (std::is_integral<T>::value && not std::is_same<T, bool>::value) ||
+            (std::numeric_limits<T>::is_iec559 && (sizeof(T) == 4 || sizeof(T) == 8))
+        >
+    {};
+
+    template<typename Integer>
+    constexpr auto total_order_key(Integer value) noexcept
+        -> typename std::enable_if_t<
+            std::is_integral<Integer>::value && not std::is_same<Integer, bool>::value,
+            std::make_unsigned<Integer>
+        >::type
+    {
+        using key_type = std::make_unsigned_t<Integer>;
+        return std::is_signed<Integer>::value ?
+            static_cast<key_type>(static_cast<key_type>(value) ^ (key_type(1) << (sizeof(key_type) * 8 - 1))) :
+            static_cast<key_type>(value);
+    }
+
+    template<typename FloatingPoint>
+    auto total_order_key(FloatingPoint value)
+        -> std::enable_if_t<
+            std::numeric_limits<FloatingPoint>::is_iec559 && sizeof(FloatingPoint) == 4,
+            std::uint32_t
+        >
+    {
+        auto bits = memcpy_cast<std::uint32_t>(value);
+        std::uint32_t sign_mask = -(bits >> 31);
+        return bits ^ (sign_mask | 0x80000000u);
+    }
+
+    template<typename FloatingPoint>
+    auto total_order_key(FloatingPoint value)
+        -> std::enable_if_t<
+            std::numeric_limits<FloatingPoint>::is_iec559 && sizeof(FloatingPoint) == 8,
+            std::uint64_t
+        >
+    {
+        auto bits = memcpy_cast<std::uint64_t>(value);
+        std::uint64_t sign_mask = -(bits >> 63);
+        return bits ^ (sign_mask | 0x8000000000000000u);
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Projection to the keys, with their order reversed for
+    // total_greater, used to sort with total_less and
+    // total_greater with radix sorts
+
+    template<typename Projection, bool Reverse>
+    struct total_order_key_projection
+    {
+        Projection projection;
+
+        template<typename T>
+        auto operator()(T&& value) const
+            -> decltype(auto)
+        {
+            auto&& proj = utility::as_function(projection);
+            auto key = total_order_key(proj(std::forward<T>(value)));
+            return Reverse ? static_cast<decltype(key)>(~key) : key;
+        }
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Projection to keys minus the smallest key of a collection,
+    // shifted left so that the highest bit that varies becomes
+    // the highest bit of the key: radix sorts then only have to
+    // look at the bits that actually differ between keys
+
+    template<typename KeyProjection, typename Key>
+    struct rebased_key_projection
+    {
+        KeyProjection key_projection;
+        Key min;
+        int shift;
+
+        template<typename T>
+        auto operator()(T&& value) const
+            -> Key
+        {
+            return static_cast<Key>(
+                static_cast<Key>(key_projection(std::forward<T>(value)) - min) << shift
+            );
+        }
+    };
+}}
+
+#endif // CPPSORT_DETAIL_TOTAL_ORDER_KEY_H_
@@ -43,6 +43,8 @@ namespace cppsort
     ////////////////////////////////////////////////////////////
     // Sorters
 
+    template<typename MergePolicy>
+    struct basic_tim_sorter;
     template<typename BufferProvider>
     struct block_sorter;
     struct counting_sorter;
@@ -54,17 +56,28 @@ namespace cppsort
     struct heap_sorter;
     struct insertion_sorter;
     struct integer_spread_sorter;
+    template<std::size_t NumThreads>
+    struct ips4o_sorter;
+    struct lcp_merge_sorter;
+    template<std::size_t DigitBits>
+    struct lsd_radix_sorter;
     struct merge_insertion_sorter;
     struct merge_sorter;
+    struct multikey_quick_sorter;
     struct pdq_sorter;
     struct poplar_sorter;
+    template<typename BufferProvider>
+    struct quad_sorter;
     struct quick_merge_sorter;
     struct quick_sorter;
+    template<std::size_t NumBuckets>
+    struct samplesort_sorter;
     struct selection_sorter;
     struct ska_sorter;
     struct smooth_sorter;
     struct spread_sorter;
     struct std_sorter;
+    struct string_prefix_sorter;
     struct string_spread_sorter;
     struct tim_sorter;
     struct verge_sorter;
@@ -34,17 +34,24 @@
 #include <cpp-sort/sorters/grail_sorter.h>
 #include <cpp-sort/sorters/heap_sorter.h>
 #include <cpp-sort/sorters/insertion_sorter.h>
+#include <cpp-sort/sorters/ips4o_sorter.h>
+#include <cpp-sort/sorters/lcp_merge_sorter.h>
+#include <cpp-sort/sorters/lsd_radix_sorter.h>
 #include <cpp-sort/sorters/merge_insertion_sorter.h>
 #include <cpp-sort/sorters/merge_sorter.h>
+#include <cpp-sort/sorters/multikey_quick_sorter.h>
 #include <cpp-sort/sorters/pdq_sorter.h>
 #include <cpp-sort/sorters/poplar_sorter.h>
+#include <cpp-sort/sorters/quad_sorter.h>
 #include <cpp-sort/sorters/quick_merge_sorter.h>
 #include <cpp-sort/sorters/quick_sorter.h>
+#include <cpp-sort/sorters/samplesort_sorter.h>
 #include <cpp-sort/sorters/selection_sorter.h>
 #include <cpp-sort/sorters/ska_sorter.h>
 #include <cpp-sort/sorters/smooth_sorter.h>
 #include <cpp-sort/sorters/spread_sorter.h>
 #include <cpp-sort/sorters/std_sorter.h>
+#include <cpp-sort/sorters/string_prefix_sorter.h>
 #include <cpp-sort/sorters/tim_sorter.h>
 #include <cpp-sort/sorters/verge_sorter.h>
 
@@ -27,18 +27,198 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <type_traits>
 #include <utility>
 #include <cpp-sort/adapters/hybrid_adapter.h>
 #include <cpp-sort/adapters/self_sort_adapter.h>
 #include <cpp-sort/adapters/small_array_adapter.h>
 #include <cpp-sort/adapters/stable_adapter.h>
+#include <cpp-sort/comparators/total_greater.h>
+#include <cpp-sort/comparators/total_less.h>
 #include <cpp-sort/fixed/low_comparisons_sorter.h>
+#include <cpp-sort/fixed/sorting_network_sorter.h>
+#include <cpp-sort/sorter_facade.h>
 #include <cpp-sort/sorters/merge_sorter.h>
 #include <cpp-sort/sorters/pdq_sorter.h>
 #include <cpp-sort/sorters/quick_sorter.h>
+#include <cpp-sort/sorters/ska_sorter.h>
+#include <cpp-sort/sorters/spread_sorter/string_spread_sorter.h>
+#include <cpp-sort/utility/functional.h>
+#include "../detail/iterator_traits.h"
+#include "../detail/total_order_key.h"
+#include "../detail/type_traits.h"
+
+#if __cplusplus > 201402L && __has_include(<string_view>)
+#   include <string_view>
+#endif
 
 namespace cppsort
 {
+    namespace detail
+    {
+        ////////////////////////////////////////////////////////////
+        // Keys that can be handed to a radix sort when they are
+        // compared with std::less<> or std::greater<>
+
+        template<typename Compare>
+        struct is_radix_dispatch_compare:
+            std::false_type
+        {};
+
+        template<>
+        struct is_radix_dispatch_compare<std::less<>>:
+            std::true_type
+        {};
+
+        template<>
+        struct is_radix_dispatch_compare<std::greater<>>:
+            std::true_type
+        {};
+
+        template<typename Key, typename=void>
+        struct radix_dispatch_traits
+        {
+            static constexpr bool value = false;
+        };
+
+        template<typename Key>
+        struct radix_dispatch_traits<Key, std::enable_if_t<has_total_order_key<Key>::value>>
+        {
+            // Sorting networks beat pdqsort on tiny collections, while
+            // ska_sort only wins once there are tens of thousands of keys;
+            // it sorts floating point numbers with their total order, which
+            // is compatible with std::less<> and std::greater<>
+            static constexpr bool value = true;
+            static constexpr std::ptrdiff_t network_size = 16;
+            static constexpr std::ptrdiff_t radix_threshold = 32768;
+            using sorter = ska_sorter;
+
+            static auto compare(std::less<>) -> total_less_fn { return {}; }
+            static auto compare(std::greater<>) -> total_greater_fn { return {}; }
+        };
+
+        template<typename Key>
+        struct radix_dispatch_traits<
+            Key,
+            std::enable_if_t<
+                std::is_same<Key, std::string>::value
+#if __cplusplus > 201402L && __has_include(<string_view>)
+                || std::is_same<Key, std::string_view>::value
+#endif
+                || is_wide_string<Key>::value
+            >
+        >
+        {
+            // String sort already beats pdqsort on a thousand strings,
+            // and comparison networks would swap strings too often
+            static constexpr bool value = true;
+            static constexpr std::ptrdiff_t network_size = 0;
+            static constexpr std::ptrdiff_t radix_threshold = 1024;
+            using sorter = string_spread_sorter;
+
+            static auto compare(std::less<> compare) -> std::less<> { return compare; }
+            static auto compare(std::greater<> compare) -> std::greater<> { return compare; }
+        };
+
+        ////////////////////////////////////////////////////////////
+        // Sorting networks for collections whose size is only
+        // known at runtime
+
+        template<std::size_t N, typename RandomAccessIterator,
+                 typename Compare, typename Projection>
+        auto sort_with_network(RandomAccessIterator first, Compare compare, Projection projection)
+            -> void
+        {
+            sorting_network_sorter<N>{}(first, first + N, std::move(compare), std::move(projection));
+        }
+
+        template<typename RandomAccessIterator, typename Compare,
+                 typename Projection, std::size_t... Indices>
+        auto sort_with_network(RandomAccessIterator first, std::size_t size,
+                               Compare compare, Projection projection,
+                               std::index_sequence<Indices...>)
+            -> void
+        {
+            using sort_function = void(*)(RandomAccessIterator, Compare, Projection);
+            constexpr sort_function sorters[] = {
+                &sort_with_network<Indices, RandomAccessIterator, Compare, Projection>...
+            };
+            sorters[size](std::move(first), std::move(compare), std::move(projection));
+        }
+
+        template<typename RandomAccessIterator, typename Compare, typename Projection>
+        auto sort_with_network(RandomAccessIterator, std::size_t, Compare, Projection,
+                               std::index_sequence<>)
+            -> void
+        {}
+
+        ////////////////////////////////////////////////////////////
+        // Picks a sorting network, pdqsort or a radix sort depending
+        // on the size of the collection when the keys are radix
+        // sortable, and doesn't accept anything else
+        //
+        // A function object which could also compare the elements is
+        // rejected as a projection, otherwise sorter_facade would use
+        // it as such when the other sorters use it as a comparison
+
+        struct radix_dispatch_sorter_impl
+        {
+            template<
+                typename RandomAccessIterator,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = std::enable_if_t<
+                    is_projection_iterator_v<Projection, RandomAccessIterator, Compare> &&
+                    not is_projection_iterator_v<utility::identity, RandomAccessIterator, Projection>
+                >
+            >
+            auto operator()(RandomAccessIterator first, RandomAccessIterator last,
+                            Compare compare={}, Projection projection={}) const
+                -> std::enable_if_t<
+                    is_radix_dispatch_compare<Compare>::value &&
+                    radix_dispatch_traits<projected_t<RandomAccessIterator, Projection>>::value
+                >
+            {
+                static_assert(
+                    std::is_base_of<
+                        std::random_access_iterator_tag,
+                        iterator_category_t<RandomAccessIterator>
+                    >::value,
+                    "radix_dispatch_sorter requires at least random-access iterators"
+                );
+
+                using traits = radix_dispatch_traits<projected_t<RandomAccessIterator, Projection>>;
+                auto size = last - first;
+                if (size < traits::network_size) {
+                    sort_with_network(std::move(first), size,
+                                      std::move(compare), std::move(projection),
+                                      std::make_index_sequence<traits::network_size>{});
+                } else if (size < traits::radix_threshold) {
+                    pdq_sorter{}(std::move(first), std::move(last),
+                                 std::move(compare), std::move(projection));
+                } else {
+                    using sorter = typename traits::sorter;
+                    sorter{}(std::move(first), std::move(last),
+                             traits::compare(std::move(compare)), std::move(projection));
+                }
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Sorter traits
+
+            using iterator_category = std::random_access_iterator_tag;
+            using is_always_stable = std::false_type;
+        };
+
+        struct radix_dispatch_sorter:
+            sorter_facade<radix_dispatch_sorter_impl>
+        {};
+    }
+
     ////////////////////////////////////////////////////////////
     // Unstable sorter
 
@@ -50,6 +230,7 @@ namespace cppsort
                     std::make_index_sequence<14u>
                 >,
                 quick_sorter,
+                detail::radix_dispatch_sorter,
                 pdq_sorter
             >
         >
@@ -0,0 +1,243 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_SORTERS_LSD_RADIX_SORTER_H_
+#define CPPSORT_SORTERS_LSD_RADIX_SORTER_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/comparators/total_greater.h>
+#include <cpp-sort/comparators/total_less.h>
+#include <cpp-sort/sorter_facade.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/radix_key.h>
+#include <cpp-sort/utility/static_const.h>
+#include "../detail/iterator_traits.h"
+#include "../detail/lsd_radix_sort.h"
+#include "../detail/total_order_key.h"
+#include "../detail/type_traits.h"
+
+namespace cppsort
+{
+    ////////////////////////////////////////////////////////////
+    // Sorter
+
+    namespace detail
+    {
+        template<typename T>
+        struct is_lsd_radix_sortable:
+            std::integral_constant<
+                bool,
+                std::is_integral<T>::value && not std::is_same<T, bool>::value
+            >
+        {};
+
+        template<std::size_t DigitBits>
+        struct lsd_radix_sorter_impl
+        {
+            static_assert(
+                DigitBits >= 1 && DigitBits <= 16,
+                "lsd_radix_sorter requires digits between 1 and 16 bits"
+            );
+
+            template<
+                typename RandomAccessIterator,
+                typename Projection = utility::identity,
+                typename = std::enable_if_t<
+                    is_projection_iterator_v<Projection, RandomAccessIterator>
+                >
+            >
+            auto operator()(RandomAccessIterator first, RandomAccessIterator last,
+                            Projection projection={}) const
+                -> std::enable_if_t<
+                    is_lsd_radix_sortable<projected_t<RandomAccessIterator, Projection>>::value
+                >
+            {
+                static_assert(
+                    std::is_base_of<
+                        std::random_access_iterator_tag,
+                        iterator_category_t<RandomAccessIterator>
+                    >::value,
+                    "lsd_radix_sorter requires at least random-access iterators"
+                );
+
+                using key_projection = total_order_key_projection<Projection, false>;
+                lsd_radix_sort<DigitBits>(std::move(first), std::move(last),
+                                          key_projection{std::move(projection)});
+            }
+
+            template<
+                typename RandomAccessIterator,
+                typename Projection = utility::identity,
+                typename = std::enable_if_t<
+                    is_projection_iterator_v<Projection, RandomAccessIterator, std::greater<>>
+                >
+            >
+            auto operator()(RandomAccessIterator first, RandomAccessIterator last,
+                            std::greater<>, Projection projection={}) const
+                -> std::enable_if_t<
+                    is_lsd_radix_sortable<projected_t<RandomAccessIterator, Projection>>::value
+                >
+            {
+                static_assert(
+                    std::is_base_of<
+                        std::random_access_iterator_tag,
+                        iterator_category_t<RandomAccessIterator>
+                    >::value,
+                    "lsd_radix_sorter requires at least random-access iterators"
+                );
+
+                using key_projection = total_order_key_projection<Projection, true>;
+                lsd_radix_sort<DigitBits>(std::move(first), std::move(last),
+                                          key_projection{std::move(projection)});
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Sort according to total_less or total_greater
+
+            template<
+                typename RandomAccessIterator,
+                typename Projection = utility::identity,
+                typename = std::enable_if_t<
+                    is_projection_iterator_v<Projection, RandomAccessIterator, total_less_fn>
+                >
+            >
+            auto operator()(RandomAccessIterator first, RandomAccessIterator last,
+                            total_less_fn, Projection projection={}) const
+                -> std::enable_if_t<
+                    has_total_order_key<projected_t<RandomAccessIterator, Projection>>::value
+                >
+            {
+                static_assert(
+                    std::is_base_of<
+                        std::random_access_iterator_tag,
+                        iterator_category_t<RandomAccessIterator>
+                    >::value,
+                    "lsd_radix_sorter requires at least random-access iterators"
+                );
+
+                using key_projection = total_order_key_projection<Projection, false>;
+                lsd_radix_sort<DigitBits>(std::move(first), std::move(last),
+                                          key_projection{std::move(projection)});
+            }
+
+            template<
+                typename RandomAccessIterator,
+                typename Projection = utility::identity,
+                typename = std::enable_if_t<
+                    is_projection_iterator_v<Projection, RandomAccessIterator, total_greater_fn>
+                >
+            >
+            auto operator()(RandomAccessIterator first, RandomAccessIterator last,
+                            total_greater_fn, Projection projection={}) const
+                -> std::enable_if_t<
+                    has_total_order_key<projected_t<RandomAccessIterator, Projection>>::value
+                >
+            {
+                static_assert(
+                    std::is_base_of<
+                        std::random_access_iterator_tag,
+                        iterator_category_t<RandomAccessIterator>
+                    >::value,
+                    "lsd_radix_sorter requires at least random-access iterators"
+                );
+
+                using key_projection = total_order_key_projection<Projection, true>;
+                lsd_radix_sort<DigitBits>(std::move(first), std::move(last),
+                                          key_projection{std::move(projection)});
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Composite keys made by utility::make_radix_key, as
+            // long as they fit in 64 bits
+
+            template<
+                typename RandomAccessIterator,
+                typename Projection = utility::identity
+            >
+            auto operator()(RandomAccessIterator first, RandomAccessIterator last,
+                            Projection projection={}) const
+                -> std::enable_if_t<
+                    is_packable_radix_key<projected_t<RandomAccessIterator, Projection>>::value
+                >
+            {
+                static_assert(
+                    std::is_base_of<
+                        std::random_access_iterator_tag,
+                        iterator_category_t<RandomAccessIterator>
+                    >::value,
+                    "lsd_radix_sorter requires at least random-access iterators"
+                );
+
+                lsd_radix_sort<DigitBits>(std::move(first), std::move(last),
+                                          packed_radix_key_projection<Projection>{std::move(projection)});
+            }
+
+            template<
+                typename RandomAccessIterator,
+                typename Projection = utility::identity
+            >
+            auto operator()(RandomAccessIterator first, RandomAccessIterator last,
+                            Projection projection={}) const
+                -> std::enable_if_t<
+                    is_packable_radix_key<detected_t<
+                        radix_key_adl::radix_key_t,
+                        projected_t<RandomAccessIterator, Projection>
+                    >>::value
+                >
+            {
+                operator()(std::move(first), std::move(last),
+                           radix_key_projection<Projection>{std::move(projection)});
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Sorter traits
+
+            using iterator_category = std::random_access_iterator_tag;
+            using is_always_stable = std::true_type;
+        };
+    }
+
+    template<std::size_t DigitBits = 11>
+    struct lsd_radix_sorter:
+        sorter_facade<detail::lsd_radix_sorter_impl<DigitBits>>
+    {};
+
+    ////////////////////////////////////////////////////////////
+    // Sort function
+
+    namespace
+    {
+        constexpr auto&& lsd_radix_sort
+            = utility::static_const<lsd_radix_sorter<>>::value;
+    }
+}
+
+#endif // CPPSORT_SORTERS_LSD_RADIX_SORTER_H_
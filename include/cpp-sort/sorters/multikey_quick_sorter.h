@@ -0,0 +1,148 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_SORTERS_MULTIKEY_QUICK_SORTER_H_
+#define CPPSORT_SORTERS_MULTIKEY_QUICK_SORTER_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cpp-sort/sorter_facade.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/static_const.h>
+#include "../detail/iterator_traits.h"
+#include "../detail/multikey_quicksort.h"
+#include "../detail/string_keys.h"
+#include "../detail/type_traits.h"
+
+namespace cppsort
+{
+    ////////////////////////////////////////////////////////////
+    // Sorter
+
+    namespace detail
+    {
+        struct multikey_quick_sorter_impl
+        {
+            template<
+                typename RandomAccessIterator,
+                typename Projection = utility::identity
+            >
+            auto operator()(RandomAccessIterator first, RandomAccessIterator last,
+                            Projection projection={}) const
+                -> std::enable_if_t<
+                    is_string_key<RandomAccessIterator, Projection>::value
+                >
+            {
+                static_assert(
+                    std::is_base_of<
+                        std::random_access_iterator_tag,
+                        iterator_category_t<RandomAccessIterator>
+                    >::value,
+                    "multikey_quick_sorter requires at least random-access iterators"
+                );
+
+                multikey_quicksort(std::move(first), std::move(last),
+                                   std::move(projection), nullptr);
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Sorter traits
+
+            using iterator_category = std::random_access_iterator_tag;
+            using is_always_stable = std::false_type;
+        };
+    }
+
+    struct multikey_quick_sorter:
+        sorter_facade<detail::multikey_quick_sorter_impl>
+    {};
+
+    ////////////////////////////////////////////////////////////
+    // Sort function
+
+    namespace
+    {
+        constexpr auto&& multikey_quick_sort
+            = utility::static_const<multikey_quick_sorter>::value;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Sort the strings and write the LCP array to out: the first
+    // value written is 0, then the length of the longest common
+    // prefix of every sorted string with the previous one
+
+    template<
+        typename RandomAccessIterator,
+        typename OutputIterator,
+        typename Projection = utility::identity
+    >
+    auto multikey_quick_sort_with_lcp(RandomAccessIterator first, RandomAccessIterator last,
+                                      OutputIterator out, Projection projection={})
+        -> std::enable_if_t<
+            detail::is_string_key<RandomAccessIterator, Projection>::value,
+            OutputIterator
+        >
+    {
+        static_assert(
+            std::is_base_of<
+                std::random_access_iterator_tag,
+                detail::iterator_category_t<RandomAccessIterator>
+            >::value,
+            "multikey_quick_sort_with_lcp requires at least random-access iterators"
+        );
+
+        std::vector<std::size_t> lcp(last - first);
+        detail::multikey_quicksort(std::move(first), std::move(last),
+                                   std::move(projection), lcp.data());
+        return std::copy(lcp.begin(), lcp.end(), std::move(out));
+    }
+
+    template<
+        typename RandomAccessIterable,
+        typename OutputIterator,
+        typename Projection = utility::identity
+    >
+    auto multikey_quick_sort_with_lcp(RandomAccessIterable&& iterable, OutputIterator out,
+                                      Projection projection={})
+        -> std::enable_if_t<
+            detail::is_string_key<
+                detail::remove_cvref_t<decltype(std::begin(iterable))>,
+                Projection
+            >::value,
+            OutputIterator
+        >
+    {
+        return multikey_quick_sort_with_lcp(std::begin(iterable), std::end(iterable),
+                                            std::move(out), std::move(projection));
+    }
+}
+
+#endif // CPPSORT_SORTERS_MULTIKEY_QUICK_SORTER_H_
@@ -30,13 +30,17 @@
 #include <iterator>
 #include <type_traits>
 #include <utility>
+#include <cpp-sort/comparators/total_greater.h>
+#include <cpp-sort/comparators/total_less.h>
 #include <cpp-sort/sorter_facade.h>
 #include <cpp-sort/sorter_traits.h>
 #include <cpp-sort/utility/as_function.h>
 #include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/radix_key.h>
 #include <cpp-sort/utility/static_const.h>
 #include "../detail/iterator_traits.h"
 #include "../detail/ska_sort.h"
+#include "../detail/total_order_key.h"
 #include "../detail/type_traits.h"
 
 namespace cppsort
@@ -46,6 +50,14 @@ namespace cppsort
 
     namespace detail
     {
+        template<typename T>
+        struct is_ska_integer:
+            std::integral_constant<
+                bool,
+                std::is_integral<T>::value && not std::is_same<T, bool>::value
+            >
+        {};
+
         struct ska_sorter_impl
         {
             template<
@@ -57,9 +69,10 @@ namespace cppsort
             >
             auto operator()(RandomAccessIterator first, RandomAccessIterator last,
                             Projection projection={}) const
-                -> std::enable_if_t<detail::is_ska_sortable_v<
-                    projected_t<RandomAccessIterator, Projection>
-                >>
+                -> std::enable_if_t<
+                    detail::is_ska_sortable_v<projected_t<RandomAccessIterator, Projection>> &&
+                    not is_ska_integer<projected_t<RandomAccessIterator, Projection>>::value
+                >
             {
                 static_assert(
                     std::is_base_of<
@@ -72,6 +85,113 @@ namespace cppsort
                 ska_sort(std::move(first), std::move(last), std::move(projection));
             }
 
+            template<
+                typename RandomAccessIterator,
+                typename Projection = utility::identity,
+                typename = std::enable_if_t<
+                    is_projection_iterator_v<Projection, RandomAccessIterator>
+                >
+            >
+            auto operator()(RandomAccessIterator first, RandomAccessIterator last,
+                            Projection projection={}) const
+                -> std::enable_if_t<
+                    is_ska_integer<projected_t<RandomAccessIterator, Projection>>::value
+                >
+            {
+                static_assert(
+                    std::is_base_of<
+                        std::random_access_iterator_tag,
+                        iterator_category_t<RandomAccessIterator>
+                    >::value,
+                    "ska_sorter requires at least random-access iterators"
+                );
+
+                // Only sort the bits that vary between integers
+                using key_projection = total_order_key_projection<Projection, false>;
+                ska_sort_ranged_keys(std::move(first), std::move(last),
+                                     key_projection{std::move(projection)});
+            }
+
+            template<
+                typename RandomAccessIterator,
+                typename Projection = utility::identity
+            >
+            auto operator()(RandomAccessIterator first, RandomAccessIterator last,
+                            Projection projection={}) const
+                -> std::enable_if_t<
+                    not detail::is_ska_sortable_v<projected_t<RandomAccessIterator, Projection>> &&
+                    has_radix_key<projected_t<RandomAccessIterator, Projection>>::value
+                >
+            {
+                static_assert(
+                    std::is_base_of<
+                        std::random_access_iterator_tag,
+                        iterator_category_t<RandomAccessIterator>
+                    >::value,
+                    "ska_sorter requires at least random-access iterators"
+                );
+
+                // Sort types providing a composite key with radix_key,
+                // they don't need to be comparable with operator<
+                ska_sort(std::move(first), std::move(last),
+                         radix_key_projection<Projection>{std::move(projection)});
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Sort according to total_less or total_greater
+
+            template<
+                typename RandomAccessIterator,
+                typename Projection = utility::identity,
+                typename = std::enable_if_t<
+                    is_projection_iterator_v<Projection, RandomAccessIterator, total_less_fn>
+                >
+            >
+            auto operator()(RandomAccessIterator first, RandomAccessIterator last,
+                            total_less_fn, Projection projection={}) const
+                -> std::enable_if_t<
+                    has_total_order_key<projected_t<RandomAccessIterator, Projection>>::value
+                >
+            {
+                static_assert(
+                    std::is_base_of<
+                        std::random_access_iterator_tag,
+                        iterator_category_t<RandomAccessIterator>
+                    >::value,
+                    "ska_sorter requires at least random-access iterators"
+                );
+
+                using key_projection = total_order_key_projection<Projection, false>;
+                ska_sort_ranged_keys(std::move(first), std::move(last),
+                                     key_projection{std::move(projection)});
+            }
+
+            template<
+                typename RandomAccessIterator,
+                typename Projection = utility::identity,
+                typename = std::enable_if_t<
+                    is_projection_iterator_v<Projection, RandomAccessIterator, total_greater_fn>
+                >
+            >
+            auto operator()(RandomAccessIterator first, RandomAccessIterator last,
+                            total_greater_fn, Projection projection={}) const
+                -> std::enable_if_t<
+                    has_total_order_key<projected_t<RandomAccessIterator, Projection>>::value
+                >
+            {
+                static_assert(
+                    std::is_base_of<
+                        std::random_access_iterator_tag,
+                        iterator_category_t<RandomAccessIterator>
+                    >::value,
+                    "ska_sorter requires at least random-access iterators"
+                );
+
+                using key_projection = total_order_key_projection<Projection, true>;
+                ska_sort_ranged_keys(std::move(first), std::move(last),
+                                     key_projection{std::move(projection)});
+            }
+
             ////////////////////////////////////////////////////////////
             // Sorter traits
 
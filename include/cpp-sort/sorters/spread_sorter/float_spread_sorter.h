@@ -32,11 +32,16 @@
 #include <limits>
 #include <type_traits>
 #include <utility>
+#include <cpp-sort/comparators/total_greater.h>
+#include <cpp-sort/comparators/total_less.h>
 #include <cpp-sort/sorter_facade.h>
 #include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/functional.h>
 #include <cpp-sort/utility/static_const.h>
 #include "../../detail/iterator_traits.h"
 #include "../../detail/spreadsort/float_sort.h"
+#include "../../detail/spreadsort/integer_sort.h"
+#include "../../detail/total_order_key.h"
 
 namespace cppsort
 {
@@ -72,6 +77,64 @@ namespace cppsort
                 spreadsort::float_sort(std::move(first), std::move(last), std::move(projection));
             }
 
+            ////////////////////////////////////////////////////////////
+            // Sort according to total_less or total_greater, which
+            // only needs an integer sort of the bits of the numbers
+
+            template<
+                typename RandomAccessIterator,
+                typename Projection = utility::identity,
+                typename = std::enable_if_t<
+                    is_projection_iterator_v<Projection, RandomAccessIterator, total_less_fn>
+                >
+            >
+            auto operator()(RandomAccessIterator first, RandomAccessIterator last,
+                            total_less_fn, Projection projection={}) const
+                -> std::enable_if_t<
+                    std::numeric_limits<projected_t<RandomAccessIterator, Projection>>::is_iec559 &&
+                    has_total_order_key<projected_t<RandomAccessIterator, Projection>>::value
+                >
+            {
+                static_assert(
+                    std::is_base_of<
+                        std::random_access_iterator_tag,
+                        iterator_category_t<RandomAccessIterator>
+                    >::value,
+                    "float_spread_sorter requires at least random-access iterators"
+                );
+
+                using key_projection = total_order_key_projection<Projection, false>;
+                spreadsort::integer_sort(std::move(first), std::move(last),
+                                         key_projection{std::move(projection)});
+            }
+
+            template<
+                typename RandomAccessIterator,
+                typename Projection = utility::identity,
+                typename = std::enable_if_t<
+                    is_projection_iterator_v<Projection, RandomAccessIterator, total_greater_fn>
+                >
+            >
+            auto operator()(RandomAccessIterator first, RandomAccessIterator last,
+                            total_greater_fn, Projection projection={}) const
+                -> std::enable_if_t<
+                    std::numeric_limits<projected_t<RandomAccessIterator, Projection>>::is_iec559 &&
+                    has_total_order_key<projected_t<RandomAccessIterator, Projection>>::value
+                >
+            {
+                static_assert(
+                    std::is_base_of<
+                        std::random_access_iterator_tag,
+                        iterator_category_t<RandomAccessIterator>
+                    >::value,
+                    "float_spread_sorter requires at least random-access iterators"
+                );
+
+                using key_projection = total_order_key_projection<Projection, true>;
+                spreadsort::integer_sort(std::move(first), std::move(last),
+                                         key_projection{std::move(projection)});
+            }
+
             ////////////////////////////////////////////////////////////
             // Sorter traits
 
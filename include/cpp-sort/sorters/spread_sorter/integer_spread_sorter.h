@@ -30,14 +30,21 @@
 #include <cstddef>
 #include <cstdint>
 #include <iterator>
+#include <numeric>
 #include <type_traits>
 #include <utility>
+#include <vector>
 #include <cpp-sort/sorter_facade.h>
 #include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/apply_permutation.h>
+#include <cpp-sort/utility/as_function.h>
 #include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/radix_key.h>
 #include <cpp-sort/utility/static_const.h>
 #include "../../detail/iterator_traits.h"
 #include "../../detail/spreadsort/integer_sort.h"
+#include "../../detail/spreadsort/string_sort.h"
+#include "../../detail/type_traits.h"
 
 namespace cppsort
 {
@@ -46,6 +53,44 @@ namespace cppsort
 
     namespace detail
     {
+        template<typename RandomAccessIterator, typename Projection>
+        auto sort_radix_keys(RandomAccessIterator first, RandomAccessIterator last,
+                             Projection projection, std::true_type /* fits in 64 bits */)
+            -> void
+        {
+            // Pack the fields in a single integer
+            spreadsort::integer_sort(std::move(first), std::move(last),
+                                     packed_radix_key_projection<Projection>{std::move(projection)});
+        }
+
+        template<typename RandomAccessIterator, typename Projection>
+        auto sort_radix_keys(RandomAccessIterator first, RandomAccessIterator last,
+                             Projection projection, std::false_type /* fits in 64 bits */)
+            -> void
+        {
+            // Write the big-endian bytes of every key once in a single
+            // buffer, sort the indices of the keys with a string sort
+            // and reorder the original collection accordingly
+            auto&& proj = utility::as_function(projection);
+            using key_type = remove_cvref_t<decltype(proj(*first))>;
+            constexpr std::size_t key_size = radix_key_traits<key_type>::bytes;
+
+            auto size = last - first;
+            std::vector<unsigned char> bytes(size * key_size);
+            auto out = bytes.data();
+            for (auto it = first ; it != last ; ++it) {
+                write_radix_key_bytes(proj(*it), out);
+                out += key_size;
+            }
+
+            std::vector<std::size_t> indices(size);
+            std::iota(indices.begin(), indices.end(), std::size_t(0));
+            spreadsort::string_sort(indices.begin(), indices.end(),
+                                    radix_key_bytes_projection{ bytes.data(), key_size },
+                                    static_cast<unsigned char>(0));
+            utility::detail::apply_permutation_cycles(indices.begin(), size, first);
+        }
+
         struct integer_spread_sorter_impl
         {
             template<
@@ -73,6 +118,47 @@ namespace cppsort
                 spreadsort::integer_sort(std::move(first), std::move(last), std::move(projection));
             }
 
+            ////////////////////////////////////////////////////////////
+            // Composite keys made by utility::make_radix_key
+
+            template<
+                typename RandomAccessIterator,
+                typename Projection = utility::identity
+            >
+            auto operator()(RandomAccessIterator first, RandomAccessIterator last,
+                            Projection projection={}) const
+                -> std::enable_if_t<
+                    is_radix_key<projected_t<RandomAccessIterator, Projection>>::value &&
+                    is_projection_iterator_v<Projection, RandomAccessIterator>
+                >
+            {
+                static_assert(
+                    std::is_base_of<
+                        std::random_access_iterator_tag,
+                        iterator_category_t<RandomAccessIterator>
+                    >::value,
+                    "integer_spread_sorter requires at least random-access iterators"
+                );
+
+                using key_type = projected_t<RandomAccessIterator, Projection>;
+                sort_radix_keys(std::move(first), std::move(last), std::move(projection),
+                                std::integral_constant<bool, (radix_key_traits<key_type>::bits <= 64)>{});
+            }
+
+            template<
+                typename RandomAccessIterator,
+                typename Projection = utility::identity
+            >
+            auto operator()(RandomAccessIterator first, RandomAccessIterator last,
+                            Projection projection={}) const
+                -> std::enable_if_t<
+                    has_radix_key<projected_t<RandomAccessIterator, Projection>>::value
+                >
+            {
+                operator()(std::move(first), std::move(last),
+                           radix_key_projection<Projection>{std::move(projection)});
+            }
+
             ////////////////////////////////////////////////////////////
             // Sorter traits
 
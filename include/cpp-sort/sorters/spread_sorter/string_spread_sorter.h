@@ -51,6 +51,30 @@ namespace cppsort
 
     namespace detail
     {
+        ////////////////////////////////////////////////////////////
+        // Strings of 16-bit and 32-bit code units
+
+        template<typename T>
+        struct is_wide_string:
+            std::false_type
+        {};
+
+        template<typename CharT>
+        struct is_wide_string<std::basic_string<CharT>>:
+            std::integral_constant<bool,
+                std::is_same<CharT, wchar_t>::value ||
+                std::is_same<CharT, char16_t>::value ||
+                std::is_same<CharT, char32_t>::value
+            >
+        {};
+
+#if __cplusplus > 201402L && __has_include(<string_view>)
+        template<typename CharT>
+        struct is_wide_string<std::basic_string_view<CharT>>:
+            is_wide_string<std::basic_string<CharT>>
+        {};
+#endif
+
         struct string_spread_sorter_impl
         {
             ////////////////////////////////////////////////////////////
@@ -88,12 +112,8 @@ namespace cppsort
             >
             auto operator()(RandomAccessIterator first, RandomAccessIterator last,
                             Projection projection={}) const
-                -> std::enable_if_t<(
-                        std::is_same<projected_t<RandomAccessIterator, Projection>, std::wstring>::value
-#if __cplusplus > 201402L && __has_include(<string_view>)
-                        || std::is_same<projected_t<RandomAccessIterator, Projection>, std::wstring_view>::value
-#endif
-                    ) && (sizeof(wchar_t) == 2)
+                -> std::enable_if_t<
+                    is_wide_string<projected_t<RandomAccessIterator, Projection>>::value
                 >
             {
                 static_assert(
@@ -104,6 +124,7 @@ namespace cppsort
                     "string_spread_sorter requires at least random-access iterators"
                 );
 
+                // 16-bit digits, 32-bit code units are split in two
                 std::uint16_t unused = 0;
                 spreadsort::string_sort(std::move(first), std::move(last),
                                         std::move(projection), unused);
@@ -145,12 +166,8 @@ namespace cppsort
             >
             auto operator()(RandomAccessIterator first, RandomAccessIterator last,
                             std::greater<> compare, Projection projection={}) const
-                -> std::enable_if_t<(
-                        std::is_same<projected_t<RandomAccessIterator, Projection>, std::wstring>::value
-#if __cplusplus > 201402L && __has_include(<string_view>)
-                        || std::is_same<projected_t<RandomAccessIterator, Projection>, std::wstring_view>::value
-#endif
-                    ) && (sizeof(wchar_t) == 2)
+                -> std::enable_if_t<
+                    is_wide_string<projected_t<RandomAccessIterator, Projection>>::value
                 >
             {
                 static_assert(
@@ -161,6 +178,7 @@ namespace cppsort
                     "string_spread_sorter requires at least random-access iterators"
                 );
 
+                // 16-bit digits, 32-bit code units are split in two
                 std::uint16_t unused = 0;
                 spreadsort::reverse_string_sort(std::move(first), std::move(last),
                                                 std::move(compare), std::move(projection),
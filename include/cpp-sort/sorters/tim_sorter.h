@@ -34,6 +34,7 @@
 #include <cpp-sort/sorter_facade.h>
 #include <cpp-sort/sorter_traits.h>
 #include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/merge_policies.h>
 #include <cpp-sort/utility/static_const.h>
 #include "../detail/iterator_traits.h"
 #include "../detail/timsort.h"
@@ -45,6 +46,7 @@ namespace cppsort
 
     namespace detail
     {
+        template<typename MergePolicy>
         struct tim_sorter_impl
         {
             template<
@@ -67,8 +69,8 @@ namespace cppsort
                     "tim_sorter requires at least random-access iterators"
                 );
 
-                timsort(std::move(first), std::move(last),
-                        std::move(compare), std::move(projection));
+                timsort<MergePolicy>(std::move(first), std::move(last),
+                                     std::move(compare), std::move(projection));
             }
 
             ////////////////////////////////////////////////////////////
@@ -79,8 +81,13 @@ namespace cppsort
         };
     }
 
+    template<typename MergePolicy>
+    struct basic_tim_sorter:
+        sorter_facade<detail::tim_sorter_impl<MergePolicy>>
+    {};
+
     struct tim_sorter:
-        sorter_facade<detail::tim_sorter_impl>
+        basic_tim_sorter<utility::timsort_merge_policy>
     {};
 
     ////////////////////////////////////////////////////////////
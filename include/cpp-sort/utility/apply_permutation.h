@@ -0,0 +1,192 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_UTILITY_APPLY_PERMUTATION_H_
+#define CPPSORT_UTILITY_APPLY_PERMUTATION_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/utility/iter_move.h>
+#include "../detail/iterator_traits.h"
+#include "../detail/type_traits.h"
+
+namespace cppsort
+{
+namespace utility
+{
+    ////////////////////////////////////////////////////////////
+    // Reorder one or several random-access ranges according to
+    // a permutation of indices, so that after the call:
+    //
+    //     new_range[i] == old_range[*(first_index + i)]
+    //
+    // for every range. The permutation is applied in place by
+    // following its cycles, and every range is reordered during
+    // the same pass.
+    //
+    // The highest bit of the indices is used to mark the cycles
+    // that were already processed, which means that the indices
+    // must be mutable and strictly smaller than half of the max
+    // value of their unsigned type. The permutation is restored
+    // before the function returns.
+    //
+
+    namespace detail
+    {
+        template<typename Integer>
+        constexpr auto permutation_mark_bit()
+            -> std::make_unsigned_t<Integer>
+        {
+            using unsigned_t = std::make_unsigned_t<Integer>;
+            return unsigned_t(1) << (std::numeric_limits<unsigned_t>::digits - 1);
+        }
+
+        template<typename Integer>
+        auto is_marked(Integer value)
+            -> bool
+        {
+            using unsigned_t = std::make_unsigned_t<Integer>;
+            return static_cast<unsigned_t>(value) & permutation_mark_bit<Integer>();
+        }
+
+        template<typename Integer>
+        auto mark(Integer& value)
+            -> void
+        {
+            using unsigned_t = std::make_unsigned_t<Integer>;
+            value = static_cast<Integer>(static_cast<unsigned_t>(value) | permutation_mark_bit<Integer>());
+        }
+
+        template<typename Integer>
+        auto unmark(Integer& value)
+            -> void
+        {
+            using unsigned_t = std::make_unsigned_t<Integer>;
+            value = static_cast<Integer>(static_cast<unsigned_t>(value) & ~permutation_mark_bit<Integer>());
+        }
+
+        // Type able to hold an element moved out of a range: the value
+        // type unless it can't be built from the moved element, which
+        // happens with iterators whose value type is a reference type
+        template<typename Iterator>
+        using cycle_leader_t = std::conditional_t<
+            std::is_constructible<
+                cppsort::detail::value_type_t<Iterator>,
+                cppsort::detail::rvalue_reference_t<Iterator>
+            >::value,
+            cppsort::detail::value_type_t<Iterator>,
+            cppsort::detail::remove_cvref_t<cppsort::detail::rvalue_reference_t<Iterator>>
+        >;
+
+        template<typename Tuple, typename... RandomAccessIterators, std::size_t... Indices>
+        auto move_from_tuple(Tuple& values, std::ptrdiff_t pos,
+                             std::index_sequence<Indices...>,
+                             RandomAccessIterators... firsts)
+            -> void
+        {
+            (void) std::initializer_list<int>{
+                (firsts[pos] = std::move(std::get<Indices>(values)), 0)...
+            };
+        }
+
+        template<typename IndexIterator, typename... RandomAccessIterators>
+        auto apply_permutation_cycles(IndexIterator first_index, std::ptrdiff_t size,
+                                      RandomAccessIterators... firsts)
+            -> void
+        {
+            using utility::iter_move;
+
+            for (std::ptrdiff_t start = 0 ; start < size ; ++start) {
+                auto next = static_cast<std::ptrdiff_t>(first_index[start]);
+                if (is_marked(first_index[start]) || next == start) continue;
+
+                // Move the cycle leaders out of the ranges, as values
+                // since proxy references would see them overwritten
+                std::tuple<cycle_leader_t<RandomAccessIterators>...> tmp(
+                    iter_move(firsts + start)...
+                );
+
+                std::ptrdiff_t current = start;
+                do {
+                    mark(first_index[current]);
+                    (void) std::initializer_list<int>{
+                        (firsts[current] = iter_move(firsts + next), 0)...
+                    };
+                    current = next;
+                    next = static_cast<std::ptrdiff_t>(first_index[current]);
+                } while (next != start);
+                mark(first_index[current]);
+
+                move_from_tuple(tmp, current,
+                                std::index_sequence_for<RandomAccessIterators...>{},
+                                firsts...);
+            }
+        }
+    }
+
+    template<
+        typename IndexIterator,
+        typename... RandomAccessIterators,
+        typename = std::enable_if_t<
+            std::is_integral<cppsort::detail::value_type_t<IndexIterator>>::value
+        >
+    >
+    auto apply_permutation(IndexIterator first_index, IndexIterator last_index,
+                           RandomAccessIterators... firsts)
+        -> void
+    {
+        detail::apply_permutation_cycles(first_index, std::distance(first_index, last_index),
+                                         firsts...);
+
+        // Restore the permutation
+        for (auto it = first_index ; it != last_index ; ++it) {
+            detail::unmark(*it);
+        }
+    }
+
+    template<
+        typename IndexIterable,
+        typename... RandomAccessIterables,
+        typename = std::enable_if_t<
+            std::is_integral<cppsort::detail::remove_cvref_t<
+                decltype(*std::begin(std::declval<IndexIterable&>()))
+            >>::value
+        >
+    >
+    auto apply_permutation(IndexIterable& indices, RandomAccessIterables&... iterables)
+        -> void
+    {
+        utility::apply_permutation(std::begin(indices), std::end(indices),
+                                   std::begin(iterables)...);
+    }
+}}
+
+#endif // CPPSORT_UTILITY_APPLY_PERMUTATION_H_
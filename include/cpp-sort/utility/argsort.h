@@ -0,0 +1,104 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_UTILITY_ARGSORT_H_
+#define CPPSORT_UTILITY_ARGSORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/functional.h>
+
+namespace cppsort
+{
+namespace utility
+{
+    ////////////////////////////////////////////////////////////
+    // Indirectly sort a random-access range and return the
+    // permutation of indices that would sort it, leaving the
+    // original range untouched:
+    //
+    //     sorted[i] == first[indices[i]]
+    //
+    // The returned permutation can be used with the function
+    // apply_permutation to reorder the range and any other
+    // range whose elements are associated to it. If the given
+    // sorter is stable, so is the resulting permutation.
+    //
+
+    template<
+        typename Index = std::size_t,
+        typename Sorter,
+        typename RandomAccessIterator,
+        typename Compare = std::less<>,
+        typename Projection = utility::identity,
+        typename = std::enable_if_t<
+            is_projection_iterator_v<Projection, RandomAccessIterator, Compare>
+        >
+    >
+    auto argsort(const Sorter& sorter, RandomAccessIterator first, RandomAccessIterator last,
+                 Compare compare={}, Projection projection={})
+        -> std::vector<Index>
+    {
+        static_assert(std::is_integral<Index>::value,
+                      "argsort requires an integer index type");
+
+        auto&& proj = utility::as_function(projection);
+
+        std::vector<Index> indices(std::distance(first, last));
+        std::iota(std::begin(indices), std::end(indices), Index(0));
+
+        sorter(std::begin(indices), std::end(indices), std::move(compare),
+               [&proj, &first](Index idx) -> decltype(auto) { return proj(first[idx]); });
+        return indices;
+    }
+
+    template<
+        typename Index = std::size_t,
+        typename Sorter,
+        typename RandomAccessIterable,
+        typename Compare = std::less<>,
+        typename Projection = utility::identity,
+        typename = std::enable_if_t<
+            is_projection_v<Projection, RandomAccessIterable, Compare>
+        >
+    >
+    auto argsort(const Sorter& sorter, RandomAccessIterable& iterable,
+                 Compare compare={}, Projection projection={})
+        -> std::vector<Index>
+    {
+        return utility::argsort<Index>(sorter, std::begin(iterable), std::end(iterable),
+                                       std::move(compare), std::move(projection));
+    }
+}}
+
+#endif // CPPSORT_UTILITY_ARGSORT_H_
@@ -197,6 +197,48 @@ namespace utility
         struct is_as_comparison_fn<as_comparison_fn<T>>:
             std::true_type
         {};
+
+        template<typename Function>
+        struct as_three_way_comparison_fn
+        {
+            private:
+
+                Function _func;
+
+            public:
+
+                as_three_way_comparison_fn() = delete;
+                as_three_way_comparison_fn(const as_three_way_comparison_fn&) = default;
+                as_three_way_comparison_fn(as_three_way_comparison_fn&&) = default;
+
+                template<
+                    typename Func,
+                    typename = std::enable_if_t<
+                        not std::is_same<cppsort::detail::remove_cvref_t<Func>, as_three_way_comparison_fn>::value
+                    >
+                >
+                constexpr explicit as_three_way_comparison_fn(Func&& func):
+                    _func(std::forward<Func>(func))
+                {}
+
+                template<typename T, typename U>
+                constexpr auto operator()(T&& lhs, U&& rhs) const
+                    noexcept(noexcept(_func(std::forward<T>(lhs), std::forward<U>(rhs))))
+                    -> bool
+                {
+                    return _func(std::forward<T>(lhs), std::forward<U>(rhs)) < 0;
+                }
+
+                // Used by the algorithms that need to know whether
+                // two elements are equivalent
+                template<typename T, typename U>
+                constexpr auto three_way(T&& lhs, U&& rhs) const
+                    noexcept(noexcept(_func(std::forward<T>(lhs), std::forward<U>(rhs))))
+                    -> decltype(_func(std::forward<T>(lhs), std::forward<U>(rhs)))
+                {
+                    return _func(std::forward<T>(lhs), std::forward<U>(rhs));
+                }
+        };
     }
 
     template<typename Function>
@@ -239,6 +281,16 @@ namespace utility
         return std::forward<Function>(func);
     }
 
+    // Turns a function returning a negative value, zero or a
+    // positive value - like std::string::compare or strcmp - into
+    // a comparison function that sorters can call either way
+    template<typename Function>
+    constexpr auto as_three_way_comparison(Function&& func)
+        -> detail::as_three_way_comparison_fn<cppsort::detail::remove_cvref_t<Function>>
+    {
+        return detail::as_three_way_comparison_fn<cppsort::detail::remove_cvref_t<Function>>(std::forward<Function>(func));
+    }
+
     ////////////////////////////////////////////////////////////
     // Math functions (mostly useful for buffer providers)
 
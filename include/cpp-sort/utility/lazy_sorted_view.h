@@ -0,0 +1,483 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_UTILITY_LAZY_SORTED_VIEW_H_
+#define CPPSORT_UTILITY_LAZY_SORTED_VIEW_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <functional>
+#include <iterator>
+#include <map>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/branchless_traits.h>
+#include <cpp-sort/utility/functional.h>
+#include "../detail/bitops.h"
+#include "../detail/heapsort.h"
+#include "../detail/insertion_sort.h"
+#include "../detail/iterator_traits.h"
+#include "../detail/pdqsort.h"
+
+namespace cppsort
+{
+namespace utility
+{
+    ////////////////////////////////////////////////////////////
+    // Lazily sorted view over a random-access range
+    //
+    // The elements of the view are only put in their sorted
+    // position when they are accessed, with an incremental
+    // quicksort: accessing the element at position pos only
+    // partitions the unsorted segment containing pos until
+    // pos is a pivot, and remembers the pivots so that the
+    // following accesses don't partition the same elements
+    // again. Consuming the first k elements of the view in
+    // order costs O(n + k log k) comparisons.
+    //
+    // The view modifies the underlying range: when the whole
+    // view has been traversed, the range is sorted. Elements
+    // that have not been accessed yet may be moved around by
+    // subsequent accesses, but elements which have been put
+    // in their sorted position are never moved again.
+    //
+
+    template<
+        typename RandomAccessIterator,
+        typename Compare = std::less<>,
+        typename Projection = utility::identity
+    >
+    class lazy_sorted_view
+    {
+        public:
+
+            ////////////////////////////////////////////////////////////
+            // Public types
+
+            class iterator;
+
+            using value_type        = cppsort::detail::value_type_t<RandomAccessIterator>;
+            using difference_type   = cppsort::detail::difference_type_t<RandomAccessIterator>;
+            using reference         = cppsort::detail::reference_t<RandomAccessIterator>;
+
+            ////////////////////////////////////////////////////////////
+            // Construction
+
+            lazy_sorted_view(RandomAccessIterator first, RandomAccessIterator last,
+                             Compare compare={}, Projection projection={}):
+                _first(std::move(first)),
+                _size(std::distance(_first, last)),
+                _compare(std::move(compare)),
+                _projection(std::move(projection))
+            {}
+
+            // The sorted segments describe the state of the underlying
+            // range, two views over the same range can't coexist
+            lazy_sorted_view(const lazy_sorted_view&) = delete;
+            lazy_sorted_view(lazy_sorted_view&&) = default;
+            lazy_sorted_view& operator=(const lazy_sorted_view&) = delete;
+            lazy_sorted_view& operator=(lazy_sorted_view&&) = default;
+
+            ////////////////////////////////////////////////////////////
+            // Iterators
+
+            auto begin()
+                -> iterator
+            {
+                return iterator(this, 0);
+            }
+
+            auto end()
+                -> iterator
+            {
+                return iterator(this, _size);
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Capacity
+
+            auto size() const
+                -> difference_type
+            {
+                return _size;
+            }
+
+            auto empty() const
+                -> bool
+            {
+                return _size == 0;
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Element access
+
+            auto operator[](difference_type pos)
+                -> reference
+            {
+                sort_nth(pos);
+                return _first[pos];
+            }
+
+            // Puts the element at position pos in its sorted position
+            auto sort_nth(difference_type pos)
+                -> void
+            {
+                using projected_type = cppsort::detail::projected_t<RandomAccessIterator, Projection>;
+                constexpr bool is_branchless =
+                    utility::is_probably_branchless_comparison_v<Compare, projected_type> &&
+                    utility::is_probably_branchless_projection_v<Projection, value_type>;
+
+                sort_nth_impl(pos, std::integral_constant<bool, is_branchless>{});
+            }
+
+            // Whether the element at position pos is already in its sorted position
+            auto is_sorted(difference_type pos) const
+                -> bool
+            {
+                auto it = _sorted.upper_bound(pos);
+                return it != _sorted.begin() && std::prev(it)->second > pos;
+            }
+
+        private:
+
+            template<bool Branchless>
+            auto sort_nth_impl(difference_type pos, std::integral_constant<bool, Branchless>)
+                -> void
+            {
+                using namespace cppsort::detail::pdqsort_detail;
+                auto&& comp = utility::as_function(_compare);
+                auto&& proj = utility::as_function(_projection);
+
+                // Find the unsorted segment [begin, end) containing pos, the
+                // elements before it are not greater than any of its elements
+                // and the elements after it are not smaller
+                auto it = _sorted.upper_bound(pos);
+                difference_type begin = 0;
+                if (it != _sorted.begin()) {
+                    auto prev = std::prev(it);
+                    if (prev->second > pos) return;
+                    begin = prev->second;
+                }
+                difference_type end = (it == _sorted.end()) ? _size : it->first;
+
+                int bad_allowed = cppsort::detail::log2(end - begin);
+                while (true) {
+                    difference_type size = end - begin;
+
+                    // Insertion sort is faster for small segments
+                    if (size < insertion_sort_threshold) {
+                        if (begin == 0) {
+                            cppsort::detail::insertion_sort(_first, _first + end, _compare, _projection);
+                        } else {
+                            unguarded_insertion_sort(_first + begin, _first + end,
+                                                     _compare, _projection);
+                        }
+                        mark_sorted(begin, end);
+                        return;
+                    }
+
+                    // Too many bad partitions, switch to heapsort to guarantee O(n log n)
+                    if (bad_allowed == 0) {
+                        cppsort::detail::heapsort(_first + begin, _first + end, _compare, _projection);
+                        mark_sorted(begin, end);
+                        return;
+                    }
+
+                    choose_pivot(_first + begin, _first + end, _compare, _projection);
+
+                    // When the pivot is equal to the element preceding the
+                    // segment, every element equal to the pivot is put in the
+                    // left partition, which is then sorted since all of its
+                    // elements are equal
+                    if (begin != 0 && not comp(proj(_first[begin - 1]), proj(_first[begin]))) {
+                        difference_type pivot_pos =
+                            partition_left(_first + begin, _first + end, _compare, _projection) - _first;
+                        mark_sorted(begin, pivot_pos + 1);
+                        if (pos <= pivot_pos) return;
+                        begin = pivot_pos + 1;
+                        continue;
+                    }
+
+                    auto part_result = Branchless ?
+                        partition_right_branchless(_first + begin, _first + end, _compare, _projection) :
+                        partition_right(_first + begin, _first + end, _compare, _projection);
+                    difference_type pivot_pos = part_result.first - _first;
+                    mark_sorted(pivot_pos, pivot_pos + 1);
+
+                    difference_type l_size = pivot_pos - begin;
+                    difference_type r_size = end - (pivot_pos + 1);
+                    if (l_size < size / 8 || r_size < size / 8) {
+                        --bad_allowed;
+                        break_patterns(_first + begin, part_result.first, _first + end);
+                    }
+
+                    // Only keep partitioning the segment containing pos
+                    if (pos == pivot_pos) return;
+                    if (pos < pivot_pos) {
+                        end = pivot_pos;
+                    } else {
+                        begin = pivot_pos + 1;
+                    }
+                }
+            }
+
+            // Remembers that [begin, end) is sorted, merging it with the
+            // adjacent sorted segments when possible
+            auto mark_sorted(difference_type begin, difference_type end)
+                -> void
+            {
+                auto it = _sorted.upper_bound(begin);
+                if (it != _sorted.end() && it->first == end) {
+                    end = it->second;
+                    it = _sorted.erase(it);
+                }
+                if (it != _sorted.begin() && std::prev(it)->second == begin) {
+                    std::prev(it)->second = end;
+                } else {
+                    _sorted.emplace_hint(it, begin, end);
+                }
+            }
+
+            RandomAccessIterator _first;
+            difference_type _size;
+            Compare _compare;
+            Projection _projection;
+
+            // Maps the beginning of every sorted segment to its end
+            std::map<difference_type, difference_type> _sorted;
+    };
+
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    class lazy_sorted_view<RandomAccessIterator, Compare, Projection>::iterator
+    {
+        public:
+
+            ////////////////////////////////////////////////////////////
+            // Public types
+
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type        = typename lazy_sorted_view::value_type;
+            using difference_type   = typename lazy_sorted_view::difference_type;
+            using pointer           = cppsort::detail::pointer_t<RandomAccessIterator>;
+            using reference         = typename lazy_sorted_view::reference;
+
+            ////////////////////////////////////////////////////////////
+            // Constructors
+
+            iterator() = default;
+
+            iterator(lazy_sorted_view* view, difference_type pos):
+                _view(view),
+                _pos(pos)
+            {}
+
+            ////////////////////////////////////////////////////////////
+            // Members access
+
+            auto base() const
+                -> RandomAccessIterator
+            {
+                return _view->_first + _pos;
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Element access
+
+            auto operator*() const
+                -> reference
+            {
+                return (*_view)[_pos];
+            }
+
+            auto operator->() const
+                -> pointer
+            {
+                return &(operator*());
+            }
+
+            auto operator[](difference_type pos) const
+                -> reference
+            {
+                return (*_view)[_pos + pos];
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Increment/decrement operators
+
+            auto operator++()
+                -> iterator&
+            {
+                ++_pos;
+                return *this;
+            }
+
+            auto operator++(int)
+                -> iterator
+            {
+                auto tmp = *this;
+                operator++();
+                return tmp;
+            }
+
+            auto operator--()
+                -> iterator&
+            {
+                --_pos;
+                return *this;
+            }
+
+            auto operator--(int)
+                -> iterator
+            {
+                auto tmp = *this;
+                operator--();
+                return tmp;
+            }
+
+            auto operator+=(difference_type increment)
+                -> iterator&
+            {
+                _pos += increment;
+                return *this;
+            }
+
+            auto operator-=(difference_type increment)
+                -> iterator&
+            {
+                _pos -= increment;
+                return *this;
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Comparison operators
+
+            friend auto operator==(const iterator& lhs, const iterator& rhs)
+                -> bool
+            {
+                return lhs._pos == rhs._pos;
+            }
+
+            friend auto operator!=(const iterator& lhs, const iterator& rhs)
+                -> bool
+            {
+                return lhs._pos != rhs._pos;
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Relational operators
+
+            friend auto operator<(const iterator& lhs, const iterator& rhs)
+                -> bool
+            {
+                return lhs._pos < rhs._pos;
+            }
+
+            friend auto operator<=(const iterator& lhs, const iterator& rhs)
+                -> bool
+            {
+                return lhs._pos <= rhs._pos;
+            }
+
+            friend auto operator>(const iterator& lhs, const iterator& rhs)
+                -> bool
+            {
+                return lhs._pos > rhs._pos;
+            }
+
+            friend auto operator>=(const iterator& lhs, const iterator& rhs)
+                -> bool
+            {
+                return lhs._pos >= rhs._pos;
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Arithmetic operators
+
+            friend auto operator+(iterator it, difference_type size)
+                -> iterator
+            {
+                return it += size;
+            }
+
+            friend auto operator+(difference_type size, iterator it)
+                -> iterator
+            {
+                return it += size;
+            }
+
+            friend auto operator-(iterator it, difference_type size)
+                -> iterator
+            {
+                return it -= size;
+            }
+
+            friend auto operator-(const iterator& lhs, const iterator& rhs)
+                -> difference_type
+            {
+                return lhs._pos - rhs._pos;
+            }
+
+        private:
+
+            lazy_sorted_view* _view = nullptr;
+            difference_type _pos = 0;
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Construction functions
+
+    template<
+        typename RandomAccessIterator,
+        typename Compare = std::less<>,
+        typename Projection = utility::identity,
+        typename = std::enable_if_t<
+            is_projection_iterator_v<Projection, RandomAccessIterator, Compare>
+        >
+    >
+    auto make_lazy_sorted_view(RandomAccessIterator first, RandomAccessIterator last,
+                               Compare compare={}, Projection projection={})
+        -> lazy_sorted_view<RandomAccessIterator, Compare, Projection>
+    {
+        return { std::move(first), std::move(last), std::move(compare), std::move(projection) };
+    }
+
+    template<
+        typename RandomAccessIterable,
+        typename Compare = std::less<>,
+        typename Projection = utility::identity,
+        typename = std::enable_if_t<
+            is_projection_v<Projection, RandomAccessIterable, Compare>
+        >
+    >
+    auto make_lazy_sorted_view(RandomAccessIterable& iterable,
+                               Compare compare={}, Projection projection={})
+        -> lazy_sorted_view<decltype(std::begin(iterable)), Compare, Projection>
+    {
+        return { std::begin(iterable), std::end(iterable), std::move(compare), std::move(projection) };
+    }
+}}
+
+#endif // CPPSORT_UTILITY_LAZY_SORTED_VIEW_H_
@@ -0,0 +1,226 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_UTILITY_MERGE_POLICIES_H_
+#define CPPSORT_UTILITY_MERGE_POLICIES_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace cppsort
+{
+namespace utility
+{
+    //
+    // Merge policies decide in which order the runs found by
+    // natural merge sorts such as tim_sorter are merged. A new
+    // policy object is created for every sort, and it has to
+    // provide the following member functions:
+    //
+    //   * collapse(runs): called every time a new run is pushed
+    //     on top of the stack of pending runs
+    //   * force_collapse(runs): called once every run has been
+    //     found, must leave a single run on the stack
+    //
+    // The runs parameter gives access to the stack of pending
+    // runs with size(), total_length(), offset(pos), length(pos),
+    // merge_at(pos) which merges the runs at positions pos and
+    // pos + 1, and merge_runs(pos, count) which merges count
+    // consecutive runs at once
+    //
+
+    ////////////////////////////////////////////////////////////
+    // Original TimSort policy
+
+    struct timsort_merge_policy
+    {
+        // Maintain the invariants of the original TimSort, with
+        // the fix for the stack overflow found by de Gouw et al.
+
+        template<typename Runs>
+        auto collapse(Runs& runs)
+            -> void
+        {
+            while (runs.size() > 1) {
+                std::size_t n = runs.size() - 2;
+
+                if ((n > 0 && runs.length(n - 1) <= runs.length(n) + runs.length(n + 1))
+                    || (n > 1 && runs.length(n - 2) <= runs.length(n - 1) + runs.length(n))) {
+                    if (runs.length(n - 1) < runs.length(n + 1)) {
+                        --n;
+                    }
+                    runs.merge_at(n);
+                }
+                else if (runs.length(n) <= runs.length(n + 1)) {
+                    runs.merge_at(n);
+                }
+                else {
+                    break;
+                }
+            }
+        }
+
+        template<typename Runs>
+        auto force_collapse(Runs& runs)
+            -> void
+        {
+            while (runs.size() > 1) {
+                std::size_t n = runs.size() - 2;
+
+                if (n > 0 && runs.length(n - 1) < runs.length(n + 1)) {
+                    --n;
+                }
+                runs.merge_at(n);
+            }
+        }
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Powersort policy
+
+    struct powersort_merge_policy
+    {
+        // Merge policy described by J. Ian Munro and Sebastian
+        // Wild in *Nearly-Optimal Mergesorts: Fast, Practical
+        // Sorting Methods That Optimally Adapt to Existing Runs*:
+        // every boundary between two runs is given a power which
+        // is the depth of the boundary in a near-optimal merge
+        // tree, and runs are merged when the stack holds a
+        // boundary with a bigger power than the newest one
+
+        template<typename Runs>
+        auto collapse(Runs& runs)
+            -> void
+        {
+            if (runs.size() < 2) {
+                return;
+            }
+
+            std::size_t top = runs.size() - 2;
+            int power = node_power(runs.total_length(), runs.offset(top),
+                                   runs.length(top), runs.length(top + 1));
+            while (not powers_.empty() && powers_.back() > power) {
+                // Merge the two runs below the newest one
+                runs.merge_at(runs.size() - 3);
+                powers_.pop_back();
+            }
+            powers_.push_back(power);
+        }
+
+        template<typename Runs>
+        auto force_collapse(Runs& runs)
+            -> void
+        {
+            while (runs.size() > 1) {
+                runs.merge_at(runs.size() - 2);
+            }
+            powers_.clear();
+        }
+
+        private:
+
+            template<typename Difference>
+            static auto node_power(Difference size, Difference offset,
+                                   Difference length1, Difference length2)
+                -> int
+            {
+                // Number of leading common bits of the binary expansions
+                // of the midpoints of both runs divided by the size of the
+                // range, computed without division nor floating point
+                Difference a = 2 * offset + length1;
+                Difference b = a + length1 + length2;
+                int power = 0;
+                while (true) {
+                    ++power;
+                    if (a >= size) {
+                        a -= size;
+                        b -= size;
+                    } else if (b >= size) {
+                        break;
+                    }
+                    a *= 2;
+                    b *= 2;
+                }
+                return power;
+            }
+
+            // Powers of the boundaries between the pending runs
+            std::vector<int> powers_;
+    };
+
+    ////////////////////////////////////////////////////////////
+    // K-way merge policy
+
+    template<std::size_t K = 4>
+    struct kway_merge_policy
+    {
+        static_assert(K >= 2, "kway_merge_policy must merge at least two runs at once");
+
+        // Merge runs K by K: runs that are the result of the same
+        // number of merges form a level, and whenever the top of
+        // the stack holds K runs of the same level, they are all
+        // merged at once into a single run of the next level
+
+        template<typename Runs>
+        auto collapse(Runs& runs)
+            -> void
+        {
+            levels_.push_back(0);
+            while (levels_.size() >= K) {
+                auto first_level = levels_.end() - K;
+                if (not std::all_of(first_level, levels_.end(), [&](int level) {
+                    return level == levels_.back();
+                })) {
+                    break;
+                }
+
+                runs.merge_runs(runs.size() - K, K);
+                int level = levels_.back() + 1;
+                levels_.erase(first_level, levels_.end());
+                levels_.push_back(level);
+            }
+        }
+
+        template<typename Runs>
+        auto force_collapse(Runs& runs)
+            -> void
+        {
+            while (runs.size() > 1) {
+                std::size_t count = std::min(K, runs.size());
+                runs.merge_runs(runs.size() - count, count);
+            }
+            levels_.clear();
+        }
+
+        private:
+
+            // Number of merges behind every pending run
+            std::vector<int> levels_;
+    };
+}}
+
+#endif // CPPSORT_UTILITY_MERGE_POLICIES_H_
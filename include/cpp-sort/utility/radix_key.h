@@ -0,0 +1,317 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_UTILITY_RADIX_KEY_H_
+#define CPPSORT_UTILITY_RADIX_KEY_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/utility/as_function.h>
+#include "../detail/total_order_key.h"
+#include "../detail/type_traits.h"
+
+namespace cppsort
+{
+namespace utility
+{
+    ////////////////////////////////////////////////////////////
+    // Composite keys for radix sorts
+    //
+    // make_radix_key describes a key as a sequence of fields
+    // compared lexicographically: integers of any signedness,
+    // float and double in IEEE 754 totalOrder, and fields wrapped
+    // in descending() which are sorted in descending order. The
+    // result is a tuple of unsigned integers which compares like
+    // the described key, and that every radix sorter accepts.
+    //
+    // A type can also provide its own key through a radix_key
+    // function found by argument-dependent lookup and returning
+    // the result of make_radix_key, in which case the radix
+    // sorters accept the type itself:
+    //
+    //     auto radix_key(const record& rec)
+    //     {
+    //         using cppsort::utility::make_radix_key;
+    //         using cppsort::utility::descending;
+    //         return make_radix_key(rec.tenant, descending(rec.timestamp), rec.id);
+    //     }
+    //
+    // 128-bit integers can be described as two 64-bit fields,
+    // the high one carrying the signedness
+    //
+
+    template<typename T>
+    struct descending_field
+    {
+        T value;
+    };
+
+    template<typename T>
+    constexpr auto descending(T value)
+        -> descending_field<T>
+    {
+        return { value };
+    }
+
+    namespace detail
+    {
+        template<typename T>
+        constexpr auto radix_field(T value)
+            -> decltype(cppsort::detail::total_order_key(value))
+        {
+            return cppsort::detail::total_order_key(value);
+        }
+
+        template<typename T>
+        constexpr auto radix_field(descending_field<T> field)
+            -> decltype(cppsort::detail::total_order_key(field.value))
+        {
+            using key_type = decltype(cppsort::detail::total_order_key(field.value));
+            return static_cast<key_type>(~cppsort::detail::total_order_key(field.value));
+        }
+    }
+
+    template<typename... Fields>
+    constexpr auto make_radix_key(Fields... fields)
+        -> std::tuple<decltype(detail::radix_field(fields))...>
+    {
+        return std::tuple<decltype(detail::radix_field(fields))...>(
+            detail::radix_field(fields)...
+        );
+    }
+}
+
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // Keys made of unsigned integer fields, as returned by
+    // make_radix_key
+
+    template<typename T>
+    struct is_radix_key_field:
+        std::integral_constant<
+            bool,
+            std::is_unsigned<T>::value && not std::is_same<T, bool>::value
+        >
+    {};
+
+    template<typename T>
+    struct is_radix_key:
+        std::false_type
+    {};
+
+    template<typename... Fields>
+    struct is_radix_key<std::tuple<Fields...>>:
+        conjunction<is_radix_key_field<Fields>...>
+    {};
+
+    template<typename... Fields>
+    struct radix_key_bits;
+
+    template<>
+    struct radix_key_bits<>:
+        std::integral_constant<std::size_t, 0>
+    {};
+
+    template<typename Head, typename... Tail>
+    struct radix_key_bits<Head, Tail...>:
+        std::integral_constant<
+            std::size_t,
+            sizeof(Head) * CHAR_BIT + radix_key_bits<Tail...>::value
+        >
+    {};
+
+    template<typename T>
+    struct radix_key_traits;
+
+    template<typename... Fields>
+    struct radix_key_traits<std::tuple<Fields...>>
+    {
+        static constexpr std::size_t bits = radix_key_bits<Fields...>::value;
+        static constexpr std::size_t bytes = bits / CHAR_BIT;
+    };
+
+    // Keys that can be packed into a single 64-bit integer
+    template<typename T, typename = void>
+    struct is_packable_radix_key:
+        std::false_type
+    {};
+
+    template<typename T>
+    struct is_packable_radix_key<T, std::enable_if_t<is_radix_key<T>::value>>:
+        std::integral_constant<bool, (radix_key_traits<T>::bits <= 64)>
+    {};
+
+    ////////////////////////////////////////////////////////////
+    // Customization point for user types
+
+    namespace radix_key_adl
+    {
+        template<typename T>
+        auto get_radix_key(const T& value)
+            -> decltype(radix_key(value))
+        {
+            return radix_key(value);
+        }
+
+        template<typename T>
+        using radix_key_t = decltype(get_radix_key(std::declval<const T&>()));
+    }
+
+    template<typename T>
+    using has_radix_key = conjunction<
+        is_detected<radix_key_adl::radix_key_t, T>,
+        is_radix_key<detected_t<radix_key_adl::radix_key_t, T>>
+    >;
+
+    template<typename Projection>
+    struct radix_key_projection
+    {
+        Projection projection;
+
+        template<typename T>
+        auto operator()(T&& value) const
+            -> decltype(auto)
+        {
+            auto&& proj = utility::as_function(projection);
+            return radix_key_adl::get_radix_key(proj(std::forward<T>(value)));
+        }
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Packing of keys into a single unsigned integer when they
+    // are small enough, or into big-endian bytes otherwise
+
+    template<typename Key, std::size_t... Indices>
+    auto pack_radix_key(const Key& key, std::index_sequence<Indices...>)
+        -> std::uint64_t
+    {
+        std::uint64_t res = 0;
+        int dummy[] = {
+            (res = (res << (sizeof(std::tuple_element_t<Indices, Key>) * CHAR_BIT) % 64)
+                   | std::get<Indices>(key), 0)...
+        };
+        (void) dummy;
+        return res;
+    }
+
+    template<typename Key>
+    auto pack_radix_key(const Key& key)
+        -> std::uint64_t
+    {
+        return pack_radix_key(key, std::make_index_sequence<std::tuple_size<Key>::value>{});
+    }
+
+    template<typename Field>
+    auto write_radix_field(unsigned char*& out, Field field)
+        -> void
+    {
+        for (std::size_t i = sizeof(Field) ; i > 0 ; --i) {
+            *out++ = static_cast<unsigned char>((field >> ((i - 1) * CHAR_BIT)) & 0xFFu);
+        }
+    }
+
+    template<typename Key, std::size_t... Indices>
+    auto write_radix_key_bytes(const Key& key, unsigned char* out, std::index_sequence<Indices...>)
+        -> void
+    {
+        int dummy[] = { (write_radix_field(out, std::get<Indices>(key)), 0)... };
+        (void) dummy;
+    }
+
+    template<typename Key>
+    auto write_radix_key_bytes(const Key& key, unsigned char* out)
+        -> void
+    {
+        write_radix_key_bytes(key, out, std::make_index_sequence<std::tuple_size<Key>::value>{});
+    }
+
+    // View of the bytes of a key written in a contiguous buffer,
+    // which string sorts can handle like a string
+    struct radix_key_bytes_view
+    {
+        const unsigned char* bytes;
+        std::size_t length;
+
+        auto data() const
+            -> const unsigned char*
+        {
+            return bytes;
+        }
+
+        auto size() const
+            -> std::size_t
+        {
+            return length;
+        }
+
+        auto operator[](std::size_t pos) const
+            -> unsigned char
+        {
+            return bytes[pos];
+        }
+
+        friend auto operator<(const radix_key_bytes_view& lhs, const radix_key_bytes_view& rhs)
+            -> bool
+        {
+            return std::memcmp(lhs.bytes, rhs.bytes, lhs.length) < 0;
+        }
+    };
+
+    // Maps the index of a key to the view of its bytes
+    struct radix_key_bytes_projection
+    {
+        const unsigned char* bytes;
+        std::size_t key_size;
+
+        auto operator()(std::size_t index) const
+            -> radix_key_bytes_view
+        {
+            return { bytes + index * key_size, key_size };
+        }
+    };
+
+    template<typename Projection>
+    struct packed_radix_key_projection
+    {
+        Projection projection;
+
+        template<typename T>
+        auto operator()(T&& value) const
+            -> std::uint64_t
+        {
+            auto&& proj = utility::as_function(projection);
+            return pack_radix_key(proj(std::forward<T>(value)));
+        }
+    };
+}}
+
+#endif // CPPSORT_UTILITY_RADIX_KEY_H_
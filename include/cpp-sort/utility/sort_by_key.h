@@ -0,0 +1,194 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_UTILITY_SORT_BY_KEY_H_
+#define CPPSORT_UTILITY_SORT_BY_KEY_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/apply_permutation.h>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/zip.h>
+#include "../detail/iterator_traits.h"
+
+namespace cppsort
+{
+namespace utility
+{
+    ////////////////////////////////////////////////////////////
+    // Sort a range of keys and reorder a range of associated
+    // values accordingly, so that the value at position i is
+    // still associated to the key at position i after the call
+    //
+    // The values are never compared nor projected, and are only
+    // moved along with the keys when they are small enough: the
+    // sorter otherwise works on the keys zipped with a range of
+    // compact indices, and the resulting permutation is applied
+    // to the values in a single pass at the end. This avoids
+    // moving big payloads at every pass of radix sorters such
+    // as ska_sorter or spread_sorter.
+    //
+    // The comparison and projection only apply to the keys.
+    //
+
+    namespace detail
+    {
+        template<typename Projection>
+        struct key_projection
+        {
+            Projection projection;
+
+            template<typename T>
+            auto operator()(T&& value) const
+                -> decltype(auto)
+            {
+                auto&& proj = utility::as_function(projection);
+                return proj(std::get<0>(std::forward<T>(value)));
+            }
+        };
+
+        template<typename Index, typename Sorter, typename RandomAccessIterator1,
+                 typename RandomAccessIterator2, typename Compare, typename Projection>
+        auto sort_by_key_impl(const Sorter& sorter,
+                              RandomAccessIterator1 keys_first, RandomAccessIterator1 keys_last,
+                              RandomAccessIterator2 values_first,
+                              Compare compare, Projection projection,
+                              std::true_type /* carry values */)
+            -> void
+        {
+            auto values_last = values_first + (keys_last - keys_first);
+            sorter(utility::make_zip_iterator(keys_first, values_first),
+                   utility::make_zip_iterator(keys_last, values_last),
+                   std::move(compare),
+                   key_projection<Projection>{std::move(projection)});
+        }
+
+        template<typename Index, typename Sorter, typename RandomAccessIterator1,
+                 typename RandomAccessIterator2, typename Compare, typename Projection>
+        auto sort_by_key_impl(const Sorter& sorter,
+                              RandomAccessIterator1 keys_first, RandomAccessIterator1 keys_last,
+                              RandomAccessIterator2 values_first,
+                              Compare compare, Projection projection,
+                              std::false_type /* carry values */)
+            -> void
+        {
+            std::vector<Index> indices(keys_last - keys_first);
+            std::iota(std::begin(indices), std::end(indices), Index(0));
+
+            // Sort the keys along with their original position
+            sorter(utility::make_zip_iterator(keys_first, std::begin(indices)),
+                   utility::make_zip_iterator(keys_last, std::end(indices)),
+                   std::move(compare),
+                   key_projection<Projection>{std::move(projection)});
+
+            // Move every value to its new position once
+            utility::detail::apply_permutation_cycles(std::begin(indices), indices.size(),
+                                                      values_first);
+        }
+
+        template<typename Index, typename Sorter, typename RandomAccessIterator1,
+                 typename RandomAccessIterator2, typename Compare, typename Projection>
+        auto sort_by_key_impl(const Sorter& sorter,
+                              RandomAccessIterator1 keys_first, RandomAccessIterator1 keys_last,
+                              RandomAccessIterator2 values_first,
+                              Compare compare, Projection projection)
+            -> void
+        {
+            using value_type = cppsort::detail::value_type_t<RandomAccessIterator2>;
+            using carry_values = std::integral_constant<
+                bool,
+                sizeof(value_type) <= sizeof(Index) &&
+                std::is_nothrow_move_constructible<value_type>::value &&
+                std::is_nothrow_move_assignable<value_type>::value
+            >;
+
+            sort_by_key_impl<Index>(sorter, std::move(keys_first), std::move(keys_last),
+                                    std::move(values_first),
+                                    std::move(compare), std::move(projection),
+                                    carry_values{});
+        }
+    }
+
+    template<
+        typename Sorter,
+        typename RandomAccessIterator1,
+        typename RandomAccessIterator2,
+        typename Compare = std::less<>,
+        typename Projection = utility::identity,
+        typename = std::enable_if_t<
+            is_projection_iterator_v<Projection, RandomAccessIterator1, Compare>
+        >
+    >
+    auto sort_by_key(const Sorter& sorter,
+                     RandomAccessIterator1 keys_first, RandomAccessIterator1 keys_last,
+                     RandomAccessIterator2 values_first,
+                     Compare compare={}, Projection projection={})
+        -> void
+    {
+        // The highest bit of the indices is reserved by
+        // apply_permutation, use 32-bit indices when possible
+        // to reduce the amount of memory moved by the sorter
+        auto size = keys_last - keys_first;
+        if (static_cast<std::size_t>(size) <= std::numeric_limits<std::uint32_t>::max() / 2) {
+            detail::sort_by_key_impl<std::uint32_t>(sorter, keys_first, keys_last, values_first,
+                                                    std::move(compare), std::move(projection));
+        } else {
+            detail::sort_by_key_impl<std::size_t>(sorter, keys_first, keys_last, values_first,
+                                                  std::move(compare), std::move(projection));
+        }
+    }
+
+    template<
+        typename Sorter,
+        typename RandomAccessIterable1,
+        typename RandomAccessIterable2,
+        typename Compare = std::less<>,
+        typename Projection = utility::identity,
+        typename = std::enable_if_t<
+            is_projection_v<Projection, RandomAccessIterable1, Compare>
+        >
+    >
+    auto sort_by_key(const Sorter& sorter,
+                     RandomAccessIterable1& keys, RandomAccessIterable2& values,
+                     Compare compare={}, Projection projection={})
+        -> void
+    {
+        utility::sort_by_key(sorter, std::begin(keys), std::end(keys), std::begin(values),
+                             std::move(compare), std::move(projection));
+    }
+}}
+
+#endif // CPPSORT_UTILITY_SORT_BY_KEY_H_
@@ -0,0 +1,445 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_UTILITY_ZIP_H_
+#define CPPSORT_UTILITY_ZIP_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/utility/iter_move.h>
+#include "../detail/iterator_traits.h"
+
+namespace cppsort
+{
+namespace utility
+{
+    //
+    // This header provides a zip range over several ranges of
+    // the same size that can be sorted as if it was a single
+    // range of tuples, without materializing such a range: the
+    // elements of all the ranges are moved together, one range
+    // at a time
+    //
+    // The reference type of the zip iterator is zip_reference,
+    // a proxy which inherits from a std::tuple of references,
+    // so the usual std::tuple operations such as std::get and
+    // comparisons work for both the proxy and the value type,
+    // which is a std::tuple of values. Sorting by a single range
+    // is done with a projection, for example:
+    //
+    //     cppsort::ska_sort(cppsort::utility::zip(keys, values),
+    //                       [](auto&& x) -> decltype(auto) { return std::get<0>(x); });
+    //
+
+    ////////////////////////////////////////////////////////////
+    // Proxy reference
+
+    template<typename... Ts>
+    class zip_reference:
+        public std::tuple<Ts&...>
+    {
+        public:
+
+            using base_type = std::tuple<Ts&...>;
+
+            ////////////////////////////////////////////////////////////
+            // Construction
+
+            explicit zip_reference(Ts&... values):
+                base_type(values...)
+            {}
+
+            // Copying a proxy rebinds it, it doesn't copy the values
+            zip_reference(const zip_reference&) = default;
+            zip_reference(zip_reference&&) = default;
+
+            ////////////////////////////////////////////////////////////
+            // Assignment, always performed on the referenced values
+
+            auto operator=(const zip_reference& other)
+                -> zip_reference&
+            {
+                copy_from(other, std::index_sequence_for<Ts...>{});
+                return *this;
+            }
+
+            auto operator=(zip_reference&& other)
+                -> zip_reference&
+            {
+                move_from(other, std::index_sequence_for<Ts...>{});
+                return *this;
+            }
+
+            auto operator=(const std::tuple<Ts...>& value)
+                -> zip_reference&
+            {
+                copy_from(value, std::index_sequence_for<Ts...>{});
+                return *this;
+            }
+
+            auto operator=(std::tuple<Ts...>&& value)
+                -> zip_reference&
+            {
+                move_from(value, std::index_sequence_for<Ts...>{});
+                return *this;
+            }
+
+        private:
+
+            template<typename Tuple, std::size_t... Indices>
+            auto copy_from(const Tuple& other, std::index_sequence<Indices...>)
+                -> void
+            {
+                (void) std::initializer_list<int>{
+                    (std::get<Indices>(*this) = std::get<Indices>(other), 0)...
+                };
+            }
+
+            template<typename Tuple, std::size_t... Indices>
+            auto move_from(Tuple& other, std::index_sequence<Indices...>)
+                -> void
+            {
+                (void) std::initializer_list<int>{
+                    (std::get<Indices>(*this) = std::move(std::get<Indices>(other)), 0)...
+                };
+            }
+    };
+
+    namespace detail
+    {
+        template<typename... Ts, std::size_t... Indices>
+        auto swap_zip_references(zip_reference<Ts...>& lhs, zip_reference<Ts...>& rhs,
+                                 std::index_sequence<Indices...>)
+            -> void
+        {
+            using std::swap;
+            (void) std::initializer_list<int>{
+                (swap(std::get<Indices>(lhs), std::get<Indices>(rhs)), 0)...
+            };
+        }
+    }
+
+    template<typename... Ts>
+    auto swap(zip_reference<Ts...> lhs, zip_reference<Ts...> rhs)
+        -> void
+    {
+        detail::swap_zip_references(lhs, rhs, std::index_sequence_for<Ts...>{});
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Zip iterator
+
+    template<typename... Iterators>
+    class zip_iterator
+    {
+        public:
+
+            ////////////////////////////////////////////////////////////
+            // Public types
+
+            using iterator_category = std::common_type_t<
+                cppsort::detail::iterator_category_t<Iterators>...
+            >;
+            using value_type        = std::tuple<cppsort::detail::value_type_t<Iterators>...>;
+            using difference_type   = std::common_type_t<
+                cppsort::detail::difference_type_t<Iterators>...
+            >;
+            using pointer           = void;
+            using reference         = zip_reference<
+                std::remove_reference_t<cppsort::detail::reference_t<Iterators>>...
+            >;
+
+            ////////////////////////////////////////////////////////////
+            // Constructors
+
+            zip_iterator() = default;
+
+            explicit zip_iterator(Iterators... its):
+                _its(std::move(its)...)
+            {}
+
+            ////////////////////////////////////////////////////////////
+            // Members access
+
+            auto base() const
+                -> const std::tuple<Iterators...>&
+            {
+                return _its;
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Element access
+
+            auto operator*() const
+                -> reference
+            {
+                return dereference(std::index_sequence_for<Iterators...>{});
+            }
+
+            auto operator[](difference_type pos) const
+                -> reference
+            {
+                return *(*this + pos);
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Increment/decrement operators
+
+            auto operator++()
+                -> zip_iterator&
+            {
+                for_each_iterator([](auto& it) { ++it; }, std::index_sequence_for<Iterators...>{});
+                return *this;
+            }
+
+            auto operator++(int)
+                -> zip_iterator
+            {
+                auto tmp = *this;
+                operator++();
+                return tmp;
+            }
+
+            auto operator--()
+                -> zip_iterator&
+            {
+                for_each_iterator([](auto& it) { --it; }, std::index_sequence_for<Iterators...>{});
+                return *this;
+            }
+
+            auto operator--(int)
+                -> zip_iterator
+            {
+                auto tmp = *this;
+                operator--();
+                return tmp;
+            }
+
+            auto operator+=(difference_type increment)
+                -> zip_iterator&
+            {
+                for_each_iterator([increment](auto& it) { it += increment; },
+                                  std::index_sequence_for<Iterators...>{});
+                return *this;
+            }
+
+            auto operator-=(difference_type increment)
+                -> zip_iterator&
+            {
+                for_each_iterator([increment](auto& it) { it -= increment; },
+                                  std::index_sequence_for<Iterators...>{});
+                return *this;
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Comparison operators, only the first iterator matters
+
+            friend auto operator==(const zip_iterator& lhs, const zip_iterator& rhs)
+                -> bool
+            {
+                return std::get<0>(lhs._its) == std::get<0>(rhs._its);
+            }
+
+            friend auto operator!=(const zip_iterator& lhs, const zip_iterator& rhs)
+                -> bool
+            {
+                return std::get<0>(lhs._its) != std::get<0>(rhs._its);
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Relational operators
+
+            friend auto operator<(const zip_iterator& lhs, const zip_iterator& rhs)
+                -> bool
+            {
+                return std::get<0>(lhs._its) < std::get<0>(rhs._its);
+            }
+
+            friend auto operator<=(const zip_iterator& lhs, const zip_iterator& rhs)
+                -> bool
+            {
+                return std::get<0>(lhs._its) <= std::get<0>(rhs._its);
+            }
+
+            friend auto operator>(const zip_iterator& lhs, const zip_iterator& rhs)
+                -> bool
+            {
+                return std::get<0>(lhs._its) > std::get<0>(rhs._its);
+            }
+
+            friend auto operator>=(const zip_iterator& lhs, const zip_iterator& rhs)
+                -> bool
+            {
+                return std::get<0>(lhs._its) >= std::get<0>(rhs._its);
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Arithmetic operators
+
+            friend auto operator+(zip_iterator it, difference_type size)
+                -> zip_iterator
+            {
+                return it += size;
+            }
+
+            friend auto operator+(difference_type size, zip_iterator it)
+                -> zip_iterator
+            {
+                return it += size;
+            }
+
+            friend auto operator-(zip_iterator it, difference_type size)
+                -> zip_iterator
+            {
+                return it -= size;
+            }
+
+            friend auto operator-(const zip_iterator& lhs, const zip_iterator& rhs)
+                -> difference_type
+            {
+                return std::get<0>(lhs._its) - std::get<0>(rhs._its);
+            }
+
+            ////////////////////////////////////////////////////////////
+            // iter_move and iter_swap, performed range by range
+
+            friend auto iter_move(const zip_iterator& it)
+                -> value_type
+            {
+                return it.move_values(std::index_sequence_for<Iterators...>{});
+            }
+
+            friend auto iter_swap(const zip_iterator& lhs, const zip_iterator& rhs)
+                -> void
+            {
+                lhs.swap_values(rhs, std::index_sequence_for<Iterators...>{});
+            }
+
+        private:
+
+            template<std::size_t... Indices>
+            auto dereference(std::index_sequence<Indices...>) const
+                -> reference
+            {
+                return reference(*std::get<Indices>(_its)...);
+            }
+
+            template<std::size_t... Indices>
+            auto move_values(std::index_sequence<Indices...>) const
+                -> value_type
+            {
+                using utility::iter_move;
+                return value_type(iter_move(std::get<Indices>(_its))...);
+            }
+
+            template<std::size_t... Indices>
+            auto swap_values(const zip_iterator& other, std::index_sequence<Indices...>) const
+                -> void
+            {
+                using utility::iter_swap;
+                (void) std::initializer_list<int>{
+                    (iter_swap(std::get<Indices>(_its), std::get<Indices>(other._its)), 0)...
+                };
+            }
+
+            template<typename Function, std::size_t... Indices>
+            auto for_each_iterator(Function func, std::index_sequence<Indices...>)
+                -> void
+            {
+                (void) std::initializer_list<int>{
+                    (func(std::get<Indices>(_its)), 0)...
+                };
+            }
+
+            std::tuple<Iterators...> _its;
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Zip range
+
+    template<typename... Iterators>
+    class zip_range
+    {
+        public:
+
+            using iterator = zip_iterator<Iterators...>;
+
+            zip_range(iterator first, iterator last):
+                _first(std::move(first)),
+                _last(std::move(last))
+            {}
+
+            auto begin() const
+                -> iterator
+            {
+                return _first;
+            }
+
+            auto end() const
+                -> iterator
+            {
+                return _last;
+            }
+
+            auto size() const
+                -> typename iterator::difference_type
+            {
+                return std::distance(_first, _last);
+            }
+
+        private:
+
+            iterator _first;
+            iterator _last;
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Construction functions
+
+    template<typename... Iterators>
+    auto make_zip_iterator(Iterators... its)
+        -> zip_iterator<Iterators...>
+    {
+        return zip_iterator<Iterators...>(std::move(its)...);
+    }
+
+    // All the iterables are expected to have the same size
+    template<typename... Iterables>
+    auto zip(Iterables&... iterables)
+        -> zip_range<decltype(std::begin(iterables))...>
+    {
+        return {
+            utility::make_zip_iterator(std::begin(iterables)...),
+            utility::make_zip_iterator(std::end(iterables)...)
+        };
+    }
+}}
+
+#endif // CPPSORT_UTILITY_ZIP_H_
@@ -38,12 +38,15 @@ TEMPLATE_TEST_CASE( "every sorter with indirect adapter", "[indirect_adapter]",
                     cppsort::grail_sorter<>,
                     cppsort::heap_sorter,
                     cppsort::insertion_sorter,
+                    cppsort::ips4o_sorter<>,
                     cppsort::merge_insertion_sorter,
                     cppsort::merge_sorter,
                     cppsort::pdq_sorter,
                     cppsort::poplar_sorter,
+                    cppsort::quad_sorter<>,
                     cppsort::quick_merge_sorter,
                     cppsort::quick_sorter,
+                    cppsort::samplesort_sorter<>,
                     cppsort::selection_sorter,
                     cppsort::ska_sorter,
                     cppsort::smooth_sorter,
@@ -24,6 +24,7 @@
 #include <algorithm>
 #include <array>
 #include <cstddef>
+#include <functional>
 #include <iterator>
 #include <random>
 #include <vector>
@@ -60,12 +61,15 @@ TEMPLATE_TEST_CASE( "every sorter with stable adapter", "[stable_adapter]",
                     cppsort::grail_sorter<>,
                     cppsort::heap_sorter,
                     cppsort::insertion_sorter,
+                    cppsort::ips4o_sorter<>,
                     cppsort::merge_insertion_sorter,
                     cppsort::merge_sorter,
                     cppsort::pdq_sorter,
                     cppsort::poplar_sorter,
+                    cppsort::quad_sorter<cppsort::utility::fixed_buffer<0>>,
                     cppsort::quick_merge_sorter,
                     cppsort::quick_sorter,
+                    cppsort::samplesort_sorter<>,
                     cppsort::selection_sorter,
                     cppsort::smooth_sorter,
                     cppsort::std_sorter,
@@ -88,3 +92,47 @@ TEMPLATE_TEST_CASE( "every sorter with stable adapter", "[stable_adapter]",
     cppsort::stable_sort(sorter{}, collection, &wrapper::value);
     CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
 }
+
+TEMPLATE_TEST_CASE( "stable adapter with narrow integer keys", "[stable_adapter]",
+                    cppsort::pdq_sorter,
+                    cppsort::ska_sorter,
+                    cppsort::spread_sorter )
+{
+    // Integer keys of at most 32 bits are packed with their
+    // position, which allows radix sorters to be made stable
+
+    std::vector<wrapper> collection(5'000);
+    std::mt19937 engine(Catch::rngSeed());
+    int count = 0;
+    for (wrapper& wrap: collection) {
+        wrap.value = static_cast<int>(engine() % 100) - 50;
+        wrap.order = count++;
+    }
+
+    using sorter = cppsort::stable_adapter<TestType>;
+
+    SECTION( "ascending order" )
+    {
+        sorter{}(collection, &wrapper::value);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+    }
+
+    SECTION( "descending order" )
+    {
+        sorter{}(collection, std::greater<>{}, &wrapper::value);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection),
+                              [](const wrapper& lhs, const wrapper& rhs) {
+                                  if (lhs.value > rhs.value) return true;
+                                  if (rhs.value > lhs.value) return false;
+                                  return lhs.order < rhs.order;
+                              }) );
+    }
+
+    SECTION( "short keys" )
+    {
+        sorter{}(collection, [](const wrapper& wrap) {
+            return static_cast<short>(wrap.value);
+        });
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+    }
+}
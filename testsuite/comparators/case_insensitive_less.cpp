@@ -21,13 +21,31 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  * THE SOFTWARE.
  */
+#include <algorithm>
 #include <array>
+#include <cstddef>
 #include <locale>
 #include <string>
+#include <vector>
 #include <catch2/catch.hpp>
 #include <cpp-sort/comparators/case_insensitive_less.h>
 #include <cpp-sort/refined.h>
 #include <cpp-sort/sort.h>
+#include <cpp-sort/sorters/spread_sorter.h>
+#include "../string_collections.h"
+
+namespace
+{
+    auto naive_case_insensitive_less(const std::string& lhs, const std::string& rhs)
+        -> bool
+    {
+        const auto& ct = std::use_facet<std::ctype<char>>(std::locale());
+        return std::lexicographical_compare(
+            lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+            [&ct](char x, char y) { return ct.tolower(x) < ct.tolower(y); }
+        );
+    }
+}
 
 namespace sub
 {
@@ -114,3 +132,57 @@ TEST_CASE( "case-insensitive string comparison with case_insensitive_less" )
     }
 }
 
+TEST_CASE( "case_insensitive_less fast paths", "[case_insensitive_less]" )
+{
+    auto strings = make_mixed_case_strings(500);
+    auto refined_less = cppsort::refined<std::string>(cppsort::case_insensitive_less);
+
+    SECTION( "comparison results" )
+    {
+        for (std::size_t i = 0 ; i < strings.size() ; ++i) {
+            for (std::size_t j = 0 ; j < 20 ; ++j) {
+                auto& lhs = strings[i];
+                auto& rhs = strings[(i + j) % strings.size()];
+                bool expected = naive_case_insensitive_less(lhs, rhs);
+                CHECK( cppsort::case_insensitive_less(lhs, rhs) == expected );
+                CHECK( refined_less(lhs, rhs) == expected );
+            }
+        }
+    }
+
+    SECTION( "strings differing only by their case" )
+    {
+        std::string lhs(100, 'a');
+        std::string rhs(100, 'A');
+        CHECK_FALSE( refined_less(lhs, rhs) );
+        CHECK_FALSE( refined_less(rhs, lhs) );
+
+        rhs[70] = 'B';
+        CHECK( refined_less(lhs, rhs) );
+        CHECK_FALSE( refined_less(rhs, lhs) );
+
+        // Between 'Z' and 'a' in ASCII, never folded
+        rhs[70] = 'a';
+        lhs[90] = '[';
+        CHECK( refined_less(lhs, rhs) );
+        CHECK_FALSE( refined_less(rhs, lhs) );
+    }
+}
+
+TEST_CASE( "case-insensitive radix sort with case_insensitive_key",
+           "[case_insensitive_less][string_spread_sorter]" )
+{
+    auto strings = make_mixed_case_strings(5'000);
+
+    SECTION( "projection" )
+    {
+        cppsort::string_spread_sort(strings, cppsort::case_insensitive_key);
+        CHECK( std::is_sorted(strings.begin(), strings.end(), naive_case_insensitive_less) );
+    }
+
+    SECTION( "projection with a locale" )
+    {
+        cppsort::string_spread_sort(strings, cppsort::case_insensitive_key(std::locale()));
+        CHECK( std::is_sorted(strings.begin(), strings.end(), naive_case_insensitive_less) );
+    }
+}
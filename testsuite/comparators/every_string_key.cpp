@@ -0,0 +1,108 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <cpp-sort/comparators/case_insensitive_less.h>
+#include <cpp-sort/comparators/natural_less.h>
+#include <cpp-sort/sorters/spread_sorter.h>
+#include <cpp-sort/utility/sort_by_key.h>
+#include "../string_collections.h"
+
+namespace
+{
+    // Comparators that come with a function computing string
+    // keys whose order matches that of the comparator
+    struct case_insensitive
+    {
+        static auto make_strings(std::size_t size)
+            -> std::vector<std::string>
+        {
+            return make_mixed_case_strings(size);
+        }
+
+        static auto less(const std::string& lhs, const std::string& rhs)
+            -> bool
+        {
+            return cppsort::case_insensitive_less(lhs, rhs);
+        }
+
+        static auto key(const std::string& str)
+            -> std::string
+        {
+            return cppsort::case_insensitive_key(str);
+        }
+    };
+
+    struct natural
+    {
+        static auto make_strings(std::size_t size)
+            -> std::vector<std::string>
+        {
+            return make_natural_strings(size);
+        }
+
+        static auto less(const std::string& lhs, const std::string& rhs)
+            -> bool
+        {
+            return cppsort::natural_less(lhs, rhs);
+        }
+
+        static auto key(const std::string& str)
+            -> std::string
+        {
+            return cppsort::natural_key(str);
+        }
+    };
+}
+
+TEMPLATE_TEST_CASE( "test every string key", "[comparators][string_keys]",
+                    case_insensitive,
+                    natural )
+{
+    auto strings = TestType::make_strings(5'000);
+
+    SECTION( "keys order" )
+    {
+        for (std::size_t i = 0 ; i < strings.size() ; ++i) {
+            for (std::size_t j = 0 ; j < 10 ; ++j) {
+                auto& lhs = strings[i];
+                auto& rhs = strings[(i + j * 97) % strings.size()];
+                CHECK( (TestType::key(lhs) < TestType::key(rhs)) == TestType::less(lhs, rhs) );
+            }
+        }
+    }
+
+    SECTION( "sort_by_key with string_spread_sorter" )
+    {
+        std::vector<std::string> keys;
+        for (auto& str: strings) {
+            keys.push_back(TestType::key(str));
+        }
+        cppsort::utility::sort_by_key(cppsort::string_spread_sorter{}, keys, strings);
+        CHECK( std::is_sorted(strings.begin(), strings.end(), &TestType::less) );
+    }
+}
@@ -21,11 +21,17 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  * THE SOFTWARE.
  */
+#include <algorithm>
 #include <array>
+#include <cstddef>
 #include <string>
+#include <vector>
 #include <catch2/catch.hpp>
 #include <cpp-sort/comparators/natural_less.h>
 #include <cpp-sort/sort.h>
+#include <cpp-sort/sorters/string_prefix_sorter.h>
+#include <cpp-sort/utility/sort_by_key.h>
+#include "../string_collections.h"
 
 TEST_CASE( "string natural sort with natural_less" )
 {
@@ -52,3 +58,35 @@ TEST_CASE( "string natural sort with natural_less" )
     CHECK( array == expected );
 }
 
+TEST_CASE( "natural_less corner cases", "[natural_less]" )
+{
+    // Only the digits of the numbers are compared as numbers
+    CHECK( cppsort::natural_less(std::string("a1b9"), std::string("a1b10")) );
+    CHECK_FALSE( cppsort::natural_less(std::string("a1b10"), std::string("a1b9")) );
+    CHECK( cppsort::natural_less(std::string("a12"), std::string("a12b")) );
+    CHECK_FALSE( cppsort::natural_less(std::string("a12b"), std::string("a12")) );
+
+    // Zero is a number like any other
+    CHECK( cppsort::natural_less(std::string("x0a"), std::string("x00b")) );
+    CHECK_FALSE( cppsort::natural_less(std::string("x00b"), std::string("x0a")) );
+
+    // Negative chars and wide code units are only digits when they
+    // are in the range of unsigned char
+    CHECK( cppsort::natural_less(std::string("\xe9" "9"), std::string("\xe9" "10")) );
+    CHECK_FALSE( cppsort::natural_less(std::wstring(L"a\u0139\u0139"), std::wstring(L"a\u0131\u0130\u0130")) );
+}
+
+TEST_CASE( "natural sort with natural_key", "[natural_less][natural_key]" )
+{
+    auto strings = make_natural_strings(5'000);
+
+    SECTION( "sort_by_key with string_prefix_sorter" )
+    {
+        std::vector<std::string> keys;
+        for (auto& str: strings) {
+            keys.push_back(cppsort::natural_key(str));
+        }
+        cppsort::utility::sort_by_key(cppsort::string_prefix_sorter{}, keys, strings);
+        CHECK( std::is_sorted(strings.begin(), strings.end(), cppsort::natural_less) );
+    }
+}
@@ -21,11 +21,104 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  * THE SOFTWARE.
  */
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
 #include <limits>
+#include <random>
+#include <vector>
 #include <catch2/catch.hpp>
+#include <cpp-sort/adapters/hybrid_adapter.h>
+#include <cpp-sort/comparators/total_greater.h>
 #include <cpp-sort/comparators/total_less.h>
 #include <cpp-sort/sort.h>
+#include <cpp-sort/sorter_facade.h>
+#include <cpp-sort/sorters/pdq_sorter.h>
+#include <cpp-sort/sorters/ska_sorter.h>
+#include <cpp-sort/sorters/spread_sorter.h>
+
+namespace
+{
+    auto from_bits(std::uint64_t bits)
+        -> double
+    {
+        double res;
+        std::memcpy(&res, &bits, sizeof(double));
+        return res;
+    }
+
+    auto to_bits(double value)
+        -> std::uint64_t
+    {
+        std::uint64_t res;
+        std::memcpy(&res, &value, sizeof(double));
+        return res;
+    }
+
+    auto to_bits(const std::vector<double>& values)
+        -> std::vector<std::uint64_t>
+    {
+        std::vector<std::uint64_t> res;
+        for (double value: values) {
+            res.push_back(to_bits(value));
+        }
+        return res;
+    }
+
+    // Reals, zeros, infinities and NaNs of both signs and kinds
+    // with various payloads
+    auto make_special_doubles(std::size_t size)
+        -> std::vector<double>
+    {
+        std::mt19937_64 engine(Catch::rngSeed());
+        std::uniform_real_distribution<double> dist(-1000.0, 1000.0);
+
+        std::vector<double> res;
+        for (std::size_t i = 0 ; i < size ; ++i) {
+            std::uint64_t sign = (engine() % 2) << 63;
+            std::uint64_t payload = engine() % 16 + 1;
+            switch (engine() % 6) {
+                case 0:
+                    res.push_back(from_bits(sign | 0x7FF8000000000000u | payload)); // quiet NaN
+                    break;
+                case 1:
+                    res.push_back(from_bits(sign | 0x7FF0000000000000u | payload)); // signaling NaN
+                    break;
+                case 2:
+                    res.push_back(from_bits(sign | 0x7FF0000000000000u)); // infinity
+                    break;
+                case 3:
+                    res.push_back(from_bits(sign)); // zero
+                    break;
+                default:
+                    res.push_back(dist(engine));
+            }
+        }
+        return res;
+    }
+
+    // Fallback sorter which records that it was used
+    int fallback_calls = 0;
+
+    struct fallback_sorter_impl
+    {
+        template<typename Iterator, typename Compare>
+        auto operator()(Iterator first, Iterator last, Compare compare) const
+            -> void
+        {
+            ++fallback_calls;
+            cppsort::pdq_sort(first, last, compare);
+        }
+
+        using iterator_category = std::random_access_iterator_tag;
+    };
+
+    struct fallback_sorter:
+        cppsort::sorter_facade<fallback_sorter_impl>
+    {};
+}
 
 TEST_CASE( "IEEE 754 totalOrder implementation" )
 {
@@ -52,3 +145,101 @@ TEST_CASE( "IEEE 754 totalOrder implementation" )
     CHECK( std::isnan(array[7]) );
     CHECK( not std::signbit(array[7]) );
 }
+
+TEST_CASE( "IEEE 754 totalOrder for NaNs", "[total_less]" )
+{
+    double quiet = from_bits(0x7FF8000000000001u);
+    double quiet2 = from_bits(0x7FF8000000000002u);
+    double signaling = from_bits(0x7FF0000000000001u);
+    double inf = std::numeric_limits<double>::infinity();
+
+    CHECK( cppsort::total_less(inf, signaling) );
+    CHECK( cppsort::total_less(signaling, quiet) );
+    CHECK( cppsort::total_less(quiet, quiet2) );
+    CHECK( cppsort::total_less(-quiet2, -quiet) );
+    CHECK( cppsort::total_less(-quiet, -signaling) );
+    CHECK( cppsort::total_less(-signaling, -inf) );
+    CHECK_FALSE( cppsort::total_less(quiet, quiet) );
+
+    CHECK( cppsort::total_greater(quiet, signaling) );
+    CHECK( cppsort::total_greater(-signaling, -quiet) );
+    CHECK_FALSE( cppsort::total_greater(quiet, quiet) );
+}
+
+TEST_CASE( "radix sort with total_less and total_greater",
+           "[total_less][ska_sorter][float_spread_sorter]" )
+{
+    auto collection = make_special_doubles(100'000);
+
+    auto expected_less = collection;
+    std::sort(expected_less.begin(), expected_less.end(), cppsort::total_less);
+    auto expected_greater = collection;
+    std::sort(expected_greater.begin(), expected_greater.end(), cppsort::total_greater);
+
+    SECTION( "ska_sorter" )
+    {
+        auto vec = collection;
+        cppsort::ska_sort(vec, cppsort::total_less);
+        CHECK( to_bits(vec) == to_bits(expected_less) );
+
+        vec = collection;
+        cppsort::ska_sort(vec, cppsort::total_greater);
+        CHECK( to_bits(vec) == to_bits(expected_greater) );
+    }
+
+    SECTION( "float_spread_sorter" )
+    {
+        auto vec = collection;
+        cppsort::float_spread_sort(vec, cppsort::total_less);
+        CHECK( to_bits(vec) == to_bits(expected_less) );
+
+        vec = collection;
+        cppsort::float_spread_sort(vec, cppsort::total_greater);
+        CHECK( to_bits(vec) == to_bits(expected_greater) );
+    }
+
+    SECTION( "small collections" )
+    {
+        std::vector<double> vec(collection.begin(), collection.begin() + 50);
+        auto expected = vec;
+        std::sort(expected.begin(), expected.end(), cppsort::total_less);
+        cppsort::ska_sort(vec, cppsort::total_less);
+        CHECK( to_bits(vec) == to_bits(expected) );
+    }
+
+    SECTION( "hybrid_adapter routing" )
+    {
+        // spread_sorter handles total_less, so the fallback sorter
+        // should never be picked
+        using sorter = cppsort::hybrid_adapter<cppsort::spread_sorter, fallback_sorter>;
+        CHECK( cppsort::detail::is_invocable_v<cppsort::spread_sorter, std::vector<double>&,
+                                               decltype(cppsort::total_less)> );
+
+        auto vec = collection;
+        fallback_calls = 0;
+        sorter{}(vec, cppsort::total_less);
+        CHECK( fallback_calls == 0 );
+        CHECK( to_bits(vec) == to_bits(expected_less) );
+    }
+
+    SECTION( "integers and projections" )
+    {
+        std::vector<int> vec;
+        for (double value: collection) {
+            vec.push_back(static_cast<int>(std::isfinite(value) ? value : 0.0));
+        }
+        auto expected = vec;
+        std::sort(expected.begin(), expected.end(), std::greater<>{});
+        cppsort::ska_sort(vec, cppsort::total_greater);
+        CHECK( vec == expected );
+
+        std::vector<std::pair<int, float>> pairs;
+        for (double value: collection) {
+            pairs.emplace_back(0, static_cast<float>(value));
+        }
+        cppsort::float_spread_sort(pairs, cppsort::total_less, &std::pair<int, float>::second);
+        CHECK( std::is_sorted(pairs.begin(), pairs.end(), [](auto& lhs, auto& rhs) {
+            return cppsort::total_less(lhs.second, rhs.second);
+        }) );
+    }
+}
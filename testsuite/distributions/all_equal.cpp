@@ -42,11 +42,14 @@ TEMPLATE_TEST_CASE( "test sorter with all_equal distribution", "[distributions]"
                         cppsort::utility::dynamic_buffer<cppsort::utility::sqrt>
                     >,
                     cppsort::heap_sorter,
+                    cppsort::ips4o_sorter<>,
                     cppsort::merge_sorter,
                     cppsort::pdq_sorter,
                     cppsort::poplar_sorter,
+                    cppsort::quad_sorter<>,
                     cppsort::quick_merge_sorter,
                     cppsort::quick_sorter,
+                    cppsort::samplesort_sorter<>,
                     cppsort::ska_sorter,
                     cppsort::smooth_sorter,
                     cppsort::spread_sorter,
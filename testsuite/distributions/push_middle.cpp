@@ -29,6 +29,7 @@
 #include <cpp-sort/sorters.h>
 #include <cpp-sort/utility/buffer.h>
 #include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/merge_policies.h>
 #include "../distributions.h"
 
 TEMPLATE_TEST_CASE( "test sorter with push_middle distribution", "[distributions]",
@@ -42,16 +43,21 @@ TEMPLATE_TEST_CASE( "test sorter with push_middle distribution", "[distributions
                         cppsort::utility::dynamic_buffer<cppsort::utility::sqrt>
                     >,
                     cppsort::heap_sorter,
+                    cppsort::ips4o_sorter<>,
                     cppsort::merge_sorter,
                     cppsort::pdq_sorter,
                     cppsort::poplar_sorter,
+                    cppsort::quad_sorter<>,
                     cppsort::quick_merge_sorter,
                     cppsort::quick_sorter,
+                    cppsort::samplesort_sorter<>,
                     cppsort::ska_sorter,
                     cppsort::smooth_sorter,
                     cppsort::spread_sorter,
                     cppsort::std_sorter,
                     cppsort::tim_sorter,
+                    cppsort::basic_tim_sorter<cppsort::utility::powersort_merge_policy>,
+                    cppsort::basic_tim_sorter<cppsort::utility::kway_merge_policy<>>,
                     cppsort::verge_sorter )
 {
     std::vector<int> collection;
@@ -83,6 +83,18 @@ TEST_CASE( "test every instantiated sorter", "[sorters]" )
         CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
     }
 
+    SECTION( "ips4o_sorter" )
+    {
+        cppsort::ips4o_sort(collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+    }
+
+    SECTION( "lsd_radix_sorter" )
+    {
+        cppsort::lsd_radix_sort(collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+    }
+
     SECTION( "merge_insertion_sorter" )
     {
         cppsort::merge_insertion_sort(collection);
@@ -107,6 +119,12 @@ TEST_CASE( "test every instantiated sorter", "[sorters]" )
         CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
     }
 
+    SECTION( "quad_sorter" )
+    {
+        cppsort::quad_sort(collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+    }
+
     SECTION( "quick_merge_sorter" )
     {
         cppsort::quick_merge_sort(collection);
@@ -125,6 +143,12 @@ TEST_CASE( "test every instantiated sorter", "[sorters]" )
         CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
     }
 
+    SECTION( "samplesort_sorter" )
+    {
+        cppsort::samplesort_sort(collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+    }
+
     SECTION( "selection_sorter" )
     {
         cppsort::selection_sort(collection);
@@ -0,0 +1,89 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <cpp-sort/sorters/lcp_merge_sorter.h>
+#include <cpp-sort/sorters/multikey_quick_sorter.h>
+#include <cpp-sort/sorters/string_prefix_sorter.h>
+#include <cpp-sort/sort.h>
+#include "string_collections.h"
+
+TEMPLATE_TEST_CASE( "test every string sorter", "[sorters][string_sorters]",
+                    cppsort::lcp_merge_sorter,
+                    cppsort::multikey_quick_sorter,
+                    cppsort::string_prefix_sorter )
+{
+    SECTION( "short strings" )
+    {
+        auto collection = make_strings(10'000, 10);
+        auto expected = collection;
+        std::sort(std::begin(expected), std::end(expected));
+
+        cppsort::sort(TestType{}, collection);
+        CHECK( collection == expected );
+    }
+
+    SECTION( "long strings" )
+    {
+        auto collection = make_strings(10'000, 40);
+        for (auto& str: collection) {
+            str.insert(0, std::string(30, 'x'));
+        }
+        auto expected = collection;
+        std::sort(std::begin(expected), std::end(expected));
+
+        cppsort::sort(TestType{}, collection);
+        CHECK( collection == expected );
+    }
+
+    SECTION( "many equal strings" )
+    {
+        std::vector<std::string> collection;
+        for (int i = 0 ; i < 1000 ; ++i) {
+            collection.push_back(std::string(100, 'a'));
+            collection.push_back(std::string(99, 'a'));
+            collection.push_back(std::string(100, 'a') + '\0');
+        }
+        auto expected = collection;
+        std::sort(std::begin(expected), std::end(expected));
+
+        cppsort::sort(TestType{}, collection);
+        CHECK( collection == expected );
+    }
+
+    SECTION( "projection" )
+    {
+        auto strings = make_strings(5'000, 20);
+        std::vector<std::pair<int, std::string>> collection;
+        for (auto& str: strings) {
+            collection.emplace_back(0, str);
+        }
+        cppsort::sort(TestType{}, collection, &std::pair<int, std::string>::second);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+    }
+}
@@ -0,0 +1,100 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <cpp-sort/sorters/merge_sorter.h>
+#include <cpp-sort/sorters/tim_sorter.h>
+#include <cpp-sort/sorters/verge_sorter.h>
+#include <cpp-sort/sort.h>
+
+//
+// The merge algorithms of these sorters use a SIMD merge kernel
+// for 32-bit integers when the CPU supports it, these tests make
+// sure that the kernel handles every size and run layout
+//
+
+TEMPLATE_TEST_CASE( "sorters using the SIMD merge kernel", "[simd]",
+                    cppsort::merge_sorter,
+                    cppsort::tim_sorter,
+                    cppsort::verge_sorter )
+{
+    using sorter = TestType;
+    std::mt19937 engine(Catch::rngSeed());
+
+    SECTION( "signed integers with runs of uneven sizes" )
+    {
+        for (int size: { 0, 1, 7, 8, 9, 15, 16, 17, 100, 1'000, 30'000 }) {
+            std::vector<std::int32_t> collection;
+            std::uniform_int_distribution<std::int32_t> dist(-1'000'000, 1'000'000);
+            for (int i = 0 ; i < size ; ++i) {
+                collection.push_back(dist(engine));
+            }
+            // Create long sorted runs so that run-adaptive
+            // algorithms also merge big ranges
+            auto third = collection.begin() + size / 3;
+            std::sort(collection.begin(), third);
+            std::sort(third, third + size / 2, std::greater<>{});
+
+            auto expected = collection;
+            std::sort(std::begin(expected), std::end(expected));
+            cppsort::sort(sorter{}, collection);
+            CHECK( collection == expected );
+        }
+    }
+
+    SECTION( "unsigned integers and many duplicates" )
+    {
+        std::vector<std::uint32_t> collection;
+        std::uniform_int_distribution<std::uint32_t> dist(0, 9);
+        for (int i = 0 ; i < 20'000 ; ++i) {
+            // Big values check that the comparison is unsigned
+            collection.push_back(dist(engine) * 0x1FFFFFFFu);
+        }
+
+        auto expected = collection;
+        std::sort(std::begin(expected), std::end(expected));
+        cppsort::sort(sorter{}, collection);
+        CHECK( collection == expected );
+    }
+
+    SECTION( "descending order" )
+    {
+        std::vector<std::int32_t> collection;
+        std::uniform_int_distribution<std::int32_t> dist(-1'000, 1'000);
+        for (int i = 0 ; i < 20'000 ; ++i) {
+            collection.push_back(dist(engine));
+        }
+        std::sort(collection.begin() + 5'000, collection.end());
+
+        auto expected = collection;
+        std::sort(std::begin(expected), std::end(expected), std::greater<>{});
+        cppsort::sort(sorter{}, collection, std::greater<>{});
+        CHECK( collection == expected );
+    }
+}
@@ -26,6 +26,9 @@
 #include <functional>
 #include <iterator>
 #include <list>
+#include <random>
+#include <string>
+#include <utility>
 #include <vector>
 #include <catch2/catch.hpp>
 #include <cpp-sort/sorters/default_sorter.h>
@@ -105,3 +108,70 @@ TEST_CASE( "default sorter tests", "[default_sorter]" )
         CHECK( std::is_sorted(std::begin(li), std::end(li), std::greater<>{}) );
     }
 }
+
+TEST_CASE( "default sorter with radix-sortable keys", "[default_sorter]" )
+{
+    // Collections small enough for sorting networks, large enough
+    // for radix sorts, and everything in between
+    std::mt19937_64 engine(Catch::rngSeed());
+
+    SECTION( "integers of every size" )
+    {
+        for (int size: { 0, 1, 2, 7, 15, 16, 17, 1'000, 40'000 }) {
+            std::vector<long long> vec;
+            for (int i = 0 ; i < size ; ++i) {
+                vec.push_back(static_cast<long long>(engine()));
+            }
+
+            cppsort::sort(vec);
+            CHECK( std::is_sorted(std::begin(vec), std::end(vec)) );
+            std::shuffle(std::begin(vec), std::end(vec), engine);
+            cppsort::sort(vec, std::greater<>{});
+            CHECK( std::is_sorted(std::begin(vec), std::end(vec), std::greater<>{}) );
+        }
+    }
+
+    SECTION( "floating point numbers" )
+    {
+        std::vector<double> vec;
+        for (int i = 0 ; i < 40'000 ; ++i) {
+            vec.push_back(static_cast<double>(static_cast<int>(engine() % 20'000) - 10'000) / 7.0);
+        }
+        vec.push_back(-0.0);
+        vec.push_back(0.0);
+
+        cppsort::sort(vec);
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec)) );
+        cppsort::sort(vec, std::greater<>{});
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec), std::greater<>{}) );
+    }
+
+    SECTION( "strings and projections" )
+    {
+        std::vector<std::pair<std::string, int>> vec;
+        for (int i = 0 ; i < 5'000 ; ++i) {
+            vec.emplace_back(std::to_string(engine() % 1'000), i);
+        }
+
+        cppsort::sort(vec, &std::pair<std::string, int>::first);
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec), [](const auto& lhs, const auto& rhs) {
+            return lhs.first < rhs.first;
+        }) );
+        cppsort::sort(vec, std::greater<>{}, &std::pair<std::string, int>::second);
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec), [](const auto& lhs, const auto& rhs) {
+            return lhs.second > rhs.second;
+        }) );
+    }
+
+    SECTION( "other comparisons" )
+    {
+        std::vector<int> vec;
+        for (int i = 0 ; i < 40'000 ; ++i) {
+            vec.push_back(static_cast<int>(engine() % 100'000));
+        }
+        auto compare = [](int lhs, int rhs) { return lhs % 1'000 < rhs % 1'000; };
+
+        cppsort::sort(vec, compare);
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec), compare) );
+    }
+}
@@ -0,0 +1,133 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <cpp-sort/adapters/counting_adapter.h>
+#include <cpp-sort/sorters/ips4o_sorter.h>
+#include <cpp-sort/sort.h>
+#include "../distributions.h"
+
+TEST_CASE( "ips4o_sorter tests", "[ips4o_sorter]" )
+{
+    std::mt19937_64 engine(Catch::rngSeed());
+
+    SECTION( "big shuffled collections" )
+    {
+        // Big enough to use the parallel algorithm when
+        // several hardware threads are available
+        std::vector<long long> collection;
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(collection), 300'000, -1568);
+        cppsort::ips4o_sort(collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+    }
+
+    SECTION( "many equivalent elements" )
+    {
+        std::vector<int> collection;
+        auto distribution = dist::shuffled_16_values{};
+        distribution(std::back_inserter(collection), 100'000);
+        cppsort::ips4o_sort(collection, std::greater<>{});
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection), std::greater<>{}) );
+    }
+
+    SECTION( "projection and non-trivial types" )
+    {
+        std::vector<std::string> collection;
+        std::uniform_int_distribution<long long> dist(0, 1'000'000);
+        for (int i = 0 ; i < 50'000 ; ++i) {
+            collection.push_back(std::to_string(dist(engine)));
+        }
+        auto size = [](const std::string& str) { return str.size(); };
+        cppsort::ips4o_sort(collection, size);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection), [&](const auto& lhs, const auto& rhs) {
+            return size(lhs) < size(rhs);
+        }) );
+    }
+}
+
+TEST_CASE( "ips4o with several threads", "[ips4o_sorter]" )
+{
+    // Force the parallel algorithm whatever the hardware
+    std::mt19937_64 engine(Catch::rngSeed());
+
+    SECTION( "random values" )
+    {
+        std::vector<long long> collection(250'001);
+        for (auto& value: collection) {
+            value = static_cast<long long>(engine());
+        }
+        auto expected = collection;
+        std::sort(std::begin(expected), std::end(expected));
+
+        auto collection2 = collection;
+        cppsort::ips4o_sorter<2>{}(collection2);
+        CHECK( collection2 == expected );
+        auto collection3 = collection;
+        cppsort::ips4o_sorter<3>{}(collection3);
+        CHECK( collection3 == expected );
+        cppsort::ips4o_sorter<8>{}(collection);
+        CHECK( collection == expected );
+    }
+
+    SECTION( "few distinct values" )
+    {
+        std::vector<std::string> collection(70'000);
+        for (auto& value: collection) {
+            value = std::to_string(engine() % 5);
+        }
+        auto expected = collection;
+        std::sort(std::begin(expected), std::end(expected));
+
+        auto collection2 = collection;
+        cppsort::ips4o_sorter<2>{}(collection2);
+        CHECK( collection2 == expected );
+        auto collection3 = collection;
+        cppsort::ips4o_sorter<3>{}(collection3);
+        CHECK( collection3 == expected );
+        cppsort::ips4o_sorter<8>{}(collection);
+        CHECK( collection == expected );
+    }
+
+    SECTION( "stateful comparison" )
+    {
+        // comparison_counter isn't thread-safe: the sort has to
+        // run sequentially to count the comparisons correctly
+        std::vector<long long> collection(100'000);
+        for (auto& value: collection) {
+            value = static_cast<long long>(engine());
+        }
+        auto sequential = collection;
+
+        auto count = cppsort::counting_adapter<cppsort::ips4o_sorter<8>>{}(collection);
+        auto expected_count = cppsort::counting_adapter<cppsort::ips4o_sorter<1>>{}(sequential);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+        CHECK( count == expected_count );
+    }
+}
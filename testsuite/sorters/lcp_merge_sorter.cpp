@@ -0,0 +1,96 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <cpp-sort/sorters/lcp_merge_sorter.h>
+#include "../string_collections.h"
+
+TEST_CASE( "lcp_merge_sort_with_lcp tests", "[lcp_merge_sorter][lcp]" )
+{
+    SECTION( "LCP array" )
+    {
+        auto collection = make_strings(10'000, 30);
+        auto expected = collection;
+        std::sort(std::begin(expected), std::end(expected));
+
+        std::vector<std::size_t> lcp;
+        cppsort::lcp_merge_sort_with_lcp(collection, std::back_inserter(lcp));
+        CHECK( collection == expected );
+        CHECK( lcp == naive_lcp(collection) );
+    }
+
+    SECTION( "LCP array with iterators" )
+    {
+        auto collection = make_strings(1'000, 30);
+        std::vector<std::size_t> lcp(collection.size());
+        auto res = cppsort::lcp_merge_sort_with_lcp(collection.begin(), collection.end(), lcp.begin());
+        CHECK( res == lcp.end() );
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+        CHECK( lcp == naive_lcp(collection) );
+    }
+
+    SECTION( "LCP array with projection" )
+    {
+        auto strings = make_strings(5'000, 20);
+        std::vector<std::pair<int, std::string>> collection;
+        for (auto& str: strings) {
+            collection.emplace_back(0, str);
+        }
+
+        std::vector<std::size_t> lcp;
+        cppsort::lcp_merge_sort_with_lcp(collection, std::back_inserter(lcp),
+                                         &std::pair<int, std::string>::second);
+        std::sort(std::begin(strings), std::end(strings));
+        CHECK( lcp == naive_lcp(strings) );
+    }
+
+    SECTION( "small collections" )
+    {
+        std::vector<std::string> collection;
+        std::vector<std::size_t> lcp;
+        cppsort::lcp_merge_sort_with_lcp(collection, std::back_inserter(lcp));
+        CHECK( lcp.empty() );
+
+        collection = { "abc" };
+        cppsort::lcp_merge_sort_with_lcp(collection, std::back_inserter(lcp));
+        CHECK( lcp == std::vector<std::size_t>{ 0 } );
+    }
+}
+
+TEST_CASE( "lcp_merge_sorter stability", "[lcp_merge_sorter][is_stable]" )
+{
+    auto strings = make_strings(10'000, 6);
+    std::vector<std::pair<std::string, int>> collection;
+    for (std::size_t i = 0 ; i < strings.size() ; ++i) {
+        collection.emplace_back(strings[i], static_cast<int>(i));
+    }
+
+    cppsort::lcp_merge_sort(collection, &std::pair<std::string, int>::first);
+    CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+}
@@ -0,0 +1,190 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <cpp-sort/comparators/total_greater.h>
+#include <cpp-sort/comparators/total_less.h>
+#include <cpp-sort/sorters/lsd_radix_sorter.h>
+#include <cpp-sort/sort.h>
+#include <cpp-sort/utility/radix_key.h>
+#include "../distributions.h"
+
+TEST_CASE( "lsd_radix_sorter tests", "[lsd_radix_sorter]" )
+{
+    std::mt19937_64 engine(Catch::rngSeed());
+
+    SECTION( "sort with int iterable" )
+    {
+        std::vector<int> vec;
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(vec), 100'000, -50'000);
+        cppsort::lsd_radix_sort(vec);
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec)) );
+    }
+
+    SECTION( "sort with std::uint64_t and different digit widths" )
+    {
+        std::vector<std::uint64_t> vec;
+        for (int i = 0 ; i < 50'000 ; ++i) {
+            vec.push_back(engine());
+        }
+        auto expected = vec;
+        std::sort(std::begin(expected), std::end(expected));
+
+        auto vec1 = vec;
+        cppsort::sort(cppsort::lsd_radix_sorter<1>{}, vec1);
+        CHECK( vec1 == expected );
+
+        auto vec8 = vec;
+        cppsort::sort(cppsort::lsd_radix_sorter<8>{}, vec8);
+        CHECK( vec8 == expected );
+
+        auto vec16 = vec;
+        cppsort::sort(cppsort::lsd_radix_sorter<16>{}, vec16);
+        CHECK( vec16 == expected );
+    }
+
+    SECTION( "sort with std::greater" )
+    {
+        std::vector<long long> vec;
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(vec), 100'000, std::numeric_limits<long long>::min());
+        cppsort::lsd_radix_sort(vec, std::greater<>{});
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec), std::greater<>{}) );
+    }
+
+    SECTION( "sort floating point numbers with total_less and total_greater" )
+    {
+        std::vector<double> vec;
+        std::uniform_real_distribution<double> distribution(-1e6, 1e6);
+        for (int i = 0 ; i < 50'000 ; ++i) {
+            vec.push_back(distribution(engine));
+        }
+        vec.push_back(-0.0);
+        vec.push_back(0.0);
+        vec.push_back(std::numeric_limits<double>::infinity());
+        vec.push_back(-std::numeric_limits<double>::quiet_NaN());
+        vec.push_back(std::numeric_limits<double>::quiet_NaN());
+        std::shuffle(std::begin(vec), std::end(vec), engine);
+
+        cppsort::lsd_radix_sort(vec, cppsort::total_less);
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec), cppsort::total_less) );
+        cppsort::lsd_radix_sort(vec, cppsort::total_greater);
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec), cppsort::total_greater) );
+    }
+
+    SECTION( "stability with a projection" )
+    {
+        // Few different keys and small values, which makes
+        // most of the passes trivial
+        std::vector<std::pair<unsigned, int>> vec;
+        for (int i = 0 ; i < 100'000 ; ++i) {
+            vec.emplace_back(engine() % 64, i);
+        }
+        auto expected = vec;
+        std::stable_sort(std::begin(expected), std::end(expected),
+                         [](const auto& lhs, const auto& rhs) {
+                             return lhs.first < rhs.first;
+                         });
+
+        cppsort::lsd_radix_sort(vec, &std::pair<unsigned, int>::first);
+        CHECK( vec == expected );
+    }
+
+    SECTION( "stability with a non-trivial type" )
+    {
+        std::vector<std::pair<short, std::string>> vec;
+        for (int i = 0 ; i < 10'000 ; ++i) {
+            vec.emplace_back(static_cast<short>(engine() % 1000) - 500, std::to_string(i));
+        }
+        auto expected = vec;
+        std::stable_sort(std::begin(expected), std::end(expected),
+                         [](const auto& lhs, const auto& rhs) {
+                             return lhs.first > rhs.first;
+                         });
+
+        cppsort::lsd_radix_sort(vec, std::greater<>{}, &std::pair<short, std::string>::first);
+        CHECK( vec == expected );
+    }
+
+    SECTION( "composite radix keys" )
+    {
+        std::vector<std::pair<std::int16_t, std::uint32_t>> vec;
+        for (int i = 0 ; i < 50'000 ; ++i) {
+            vec.emplace_back(static_cast<std::int16_t>(engine()), static_cast<std::uint32_t>(engine()));
+        }
+        auto expected = vec;
+        std::sort(std::begin(expected), std::end(expected),
+                  [](const auto& lhs, const auto& rhs) {
+                      return lhs.first < rhs.first
+                          || (lhs.first == rhs.first && lhs.second > rhs.second);
+                  });
+
+        cppsort::lsd_radix_sort(vec, [](const auto& value) {
+            using cppsort::utility::descending;
+            using cppsort::utility::make_radix_key;
+            return make_radix_key(value.first, descending(value.second));
+        });
+        CHECK( vec == expected );
+    }
+
+    SECTION( "keys in a narrow range crossing digit boundaries" )
+    {
+        std::vector<std::uint64_t> vec;
+        for (int i = 0 ; i < 100'000 ; ++i) {
+            vec.push_back((std::uint64_t(1) << 32) - 30'000 + engine() % 60'000);
+        }
+        cppsort::sort(cppsort::lsd_radix_sorter<8>{}, vec);
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec)) );
+    }
+
+    SECTION( "large collection" )
+    {
+        // Big enough to go through the staging buffers
+        std::vector<std::uint64_t> vec;
+        for (int i = 0 ; i < 2'100'000 ; ++i) {
+            vec.push_back(engine());
+        }
+        auto expected = vec;
+        std::sort(std::begin(expected), std::end(expected), std::greater<>{});
+
+        cppsort::lsd_radix_sort(vec, std::greater<>{});
+        CHECK( vec == expected );
+    }
+
+    SECTION( "all equal keys" )
+    {
+        std::vector<int> vec(10'000, 42);
+        cppsort::lsd_radix_sort(vec);
+        CHECK( std::count(std::begin(vec), std::end(vec), 42) == 10'000 );
+    }
+}
@@ -22,10 +22,12 @@
  * THE SOFTWARE.
  */
 #include <algorithm>
+#include <cstddef>
 #include <forward_list>
 #include <functional>
 #include <iterator>
 #include <list>
+#include <random>
 #include <vector>
 #include <catch2/catch.hpp>
 #include <cpp-sort/sorters/merge_sorter.h>
@@ -91,3 +93,51 @@ TEST_CASE( "merge_sorter tests", "[merge_sorter]" )
         CHECK( std::is_sorted(std::begin(li), std::end(li), std::greater<>{}) );
     }
 }
+
+TEST_CASE( "merge_sorter branchless merge", "[merge_sorter][branchless]" )
+{
+    // Arithmetic keys go through the branchless merge, which
+    // must be stable and handle runs of uneven sizes
+
+    struct wrapper
+    {
+        int value;
+        std::size_t index;
+    };
+
+    std::mt19937 engine(Catch::rngSeed());
+    std::uniform_int_distribution<int> values_dist(0, 50);
+
+    for (std::size_t size: { 0, 1, 2, 39, 40, 41, 100, 1'000, 10'000 }) {
+        std::vector<wrapper> vec;
+        for (std::size_t i = 0 ; i < size ; ++i) {
+            vec.push_back({ values_dist(engine), i });
+        }
+        // Create a few long runs
+        std::sort(std::begin(vec), std::begin(vec) + size / 3, [](const auto& lhs, const auto& rhs) {
+            return lhs.value < rhs.value || (lhs.value == rhs.value && lhs.index < rhs.index);
+        });
+
+        auto expected = vec;
+        std::stable_sort(std::begin(expected), std::end(expected), [](const auto& lhs, const auto& rhs) {
+            return lhs.value > rhs.value;
+        });
+
+        cppsort::sort(cppsort::merge_sorter{}, vec, std::greater<>{}, &wrapper::value);
+        CHECK( std::equal(std::begin(vec), std::end(vec), std::begin(expected),
+                          [](const auto& lhs, const auto& rhs) {
+                              return lhs.value == rhs.value && lhs.index == rhs.index;
+                          }) );
+    }
+
+    SECTION( "floating point keys" )
+    {
+        std::uniform_real_distribution<double> dist(-1000.0, 1000.0);
+        std::vector<double> vec;
+        for (int i = 0 ; i < 5'000 ; ++i) {
+            vec.push_back(dist(engine));
+        }
+        cppsort::sort(cppsort::merge_sorter{}, vec);
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec)) );
+    }
+}
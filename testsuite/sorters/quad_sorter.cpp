@@ -0,0 +1,134 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <cpp-sort/sorters/quad_sorter.h>
+#include <cpp-sort/sort.h>
+#include <cpp-sort/utility/buffer.h>
+#include "../distributions.h"
+
+namespace
+{
+    struct wrapper
+    {
+        int value;
+        std::size_t index;
+    };
+
+    auto operator==(const wrapper& lhs, const wrapper& rhs)
+        -> bool
+    {
+        return lhs.value == rhs.value && lhs.index == rhs.index;
+    }
+
+    struct string_wrapper
+    {
+        std::string value;
+        std::size_t index;
+    };
+
+    auto operator==(const string_wrapper& lhs, const string_wrapper& rhs)
+        -> bool
+    {
+        return lhs.value == rhs.value && lhs.index == rhs.index;
+    }
+}
+
+TEMPLATE_TEST_CASE( "quad_sorter buffer providers", "[quad_sorter]",
+                    cppsort::utility::fixed_buffer<0>,
+                    cppsort::utility::fixed_buffer<40>,
+                    cppsort::utility::fixed_buffer<512>,
+                    cppsort::utility::dynamic_buffer<cppsort::utility::sqrt>,
+                    cppsort::utility::dynamic_buffer<cppsort::utility::half>,
+                    cppsort::utility::dynamic_buffer<cppsort::utility::identity> )
+{
+    using sorter = cppsort::quad_sorter<TestType>;
+
+    // Sorted blocks, descending blocks and plenty of equivalent
+    // elements to exercise every merging strategy
+    std::mt19937 engine(Catch::rngSeed());
+    std::uniform_int_distribution<int> run_length(1, 300);
+    std::vector<wrapper> collection;
+    while (collection.size() < 10'000) {
+        int length = run_length(engine);
+        bool descending = run_length(engine) % 2;
+        for (int i = 0 ; i < length ; ++i) {
+            int value = (descending ? length - i : i) / 3;
+            collection.push_back({ value, collection.size() });
+        }
+    }
+    std::shuffle(std::begin(collection), std::begin(collection) + 2000, engine);
+
+    auto expected = collection;
+    std::stable_sort(std::begin(expected), std::end(expected), [](const auto& lhs, const auto& rhs) {
+        return lhs.value < rhs.value;
+    });
+
+    SECTION( "stability with trivially copyable types" )
+    {
+        cppsort::sort(sorter{}, collection, &wrapper::value);
+        CHECK( collection == expected );
+    }
+
+    SECTION( "stability with other types" )
+    {
+        std::vector<string_wrapper> strings;
+        for (const auto& elem: collection) {
+            strings.push_back({ std::to_string(elem.value), elem.index });
+        }
+        std::vector<string_wrapper> expected_strings;
+        for (const auto& elem: expected) {
+            expected_strings.push_back({ std::to_string(elem.value), elem.index });
+        }
+        std::stable_sort(std::begin(expected_strings), std::end(expected_strings),
+                         [](const auto& lhs, const auto& rhs) {
+                             return lhs.value < rhs.value;
+                         });
+
+        cppsort::sort(sorter{}, strings, &string_wrapper::value);
+        CHECK( strings == expected_strings );
+    }
+
+    SECTION( "shuffled integers" )
+    {
+        std::vector<int> vec;
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(vec), 10'000, -1568);
+        cppsort::sort(sorter{}, vec);
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec)) );
+        cppsort::sort(sorter{}, vec, std::greater<>{});
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec), std::greater<>{}) );
+    }
+
+    SECTION( "is_always_stable" )
+    {
+        CHECK( cppsort::is_always_stable<sorter>::value );
+    }
+}
@@ -0,0 +1,71 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <random>
+#include <string>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <cpp-sort/sorters/quick_sorter.h>
+#include <cpp-sort/sort.h>
+#include "../distributions.h"
+
+TEST_CASE( "quick_sorter tests", "[quick_sorter]" )
+{
+    std::mt19937_64 engine(Catch::rngSeed());
+
+    SECTION( "random-access iterators" )
+    {
+        std::vector<long long> collection;
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(collection), 100'000, -1568);
+        cppsort::quick_sort(collection, std::greater<>{});
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection), std::greater<>{}) );
+    }
+
+    SECTION( "few distinct values" )
+    {
+        // Exercises the extraction of the elements equivalent
+        // to the pivots from the middle partition
+        for (int num_values: { 2, 3, 5 }) {
+            std::vector<std::string> collection;
+            for (int i = 0 ; i < 50'000 ; ++i) {
+                collection.push_back(std::to_string(engine() % num_values));
+            }
+            cppsort::quick_sort(collection);
+            CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+        }
+    }
+
+    SECTION( "forward and bidirectional iterators" )
+    {
+        std::list<int> collection;
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(collection), 10'000, -1568);
+        cppsort::quick_sort(collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+    }
+}
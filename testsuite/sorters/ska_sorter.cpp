@@ -59,6 +59,23 @@ TEST_CASE( "ska_sorter tests", "[ska_sorter]" )
         CHECK( std::is_sorted(std::begin(vec), std::end(vec)) );
     }
 
+    SECTION( "sort with integers in a narrow range" )
+    {
+        // Only the low bits vary, and the range crosses zero
+        std::vector<long long> vec;
+        for (int i = 0 ; i < 100'000 ; ++i) {
+            vec.push_back(static_cast<long long>(engine() % 5'000) - 2'500);
+        }
+        cppsort::sort(cppsort::ska_sort, vec);
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec)) );
+
+        for (auto& value: vec) {
+            value = std::numeric_limits<long long>::max() - static_cast<long long>(engine() % 70'000);
+        }
+        cppsort::sort(cppsort::ska_sort, vec);
+        CHECK( std::is_sorted(std::begin(vec), std::end(vec)) );
+    }
+
     SECTION( "sort with float iterable" )
     {
         std::vector<float> vec(100'000);
@@ -92,6 +109,28 @@ TEST_CASE( "ska_sorter tests", "[ska_sorter]" )
         cppsort::sort(cppsort::ska_sort, std::begin(vec), std::end(vec));
         CHECK( std::is_sorted(std::begin(vec), std::end(vec)) );
     }
+
+    SECTION( "sort with wide strings" )
+    {
+        // Code units with the high bit set, and a negative
+        // one when wchar_t is signed
+        std::vector<std::u16string> vec16;
+        std::vector<std::u32string> vec32;
+        std::vector<std::wstring> wvec;
+        for (int i = 0 ; i < 100'000 ; ++i) {
+            auto value = engine();
+            vec16.push_back({ char16_t(value % 3 * 0x7fff), char16_t(value % 0xffff) });
+            vec32.push_back({ char32_t(value % 3 * 0x7fffffff), char32_t(value % 0x10ffff) });
+            wvec.push_back({ wchar_t(int(value % 3) - 1), wchar_t(value % 0x7fff) });
+        }
+
+        cppsort::sort(cppsort::ska_sort, vec16);
+        CHECK( std::is_sorted(std::begin(vec16), std::end(vec16)) );
+        cppsort::sort(cppsort::ska_sort, vec32);
+        CHECK( std::is_sorted(std::begin(vec32), std::end(vec32)) );
+        cppsort::sort(cppsort::ska_sort, wvec);
+        CHECK( std::is_sorted(std::begin(wvec), std::end(wvec)) );
+    }
 }
 
 namespace
@@ -22,6 +22,8 @@
  * THE SOFTWARE.
  */
 #include <algorithm>
+#include <cstddef>
+#include <initializer_list>
 #include <iterator>
 #include <numeric>
 #include <random>
@@ -31,6 +33,29 @@
 #include <cpp-sort/sorters/spread_sorter.h>
 #include <cpp-sort/sort.h>
 
+namespace
+{
+    // Strings made of few distinct code units, which gives many
+    // common prefixes, and whose code units use every digit
+    template<typename String>
+    auto wide_strings(std::mt19937_64& engine,
+                      std::initializer_list<typename String::value_type> units)
+        -> std::vector<String>
+    {
+        std::vector<typename String::value_type> alphabet(units);
+        std::vector<String> res;
+        for (int i = 0 ; i < 100'000 ; ++i) {
+            String str;
+            auto size = engine() % 12;
+            for (std::size_t j = 0 ; j < size ; ++j) {
+                str.push_back(alphabet[engine() % alphabet.size()]);
+            }
+            res.push_back(str);
+        }
+        return res;
+    }
+}
+
 TEST_CASE( "spread_sorter tests", "[spread_sorter]" )
 {
     // Pseudo-random number engine
@@ -105,4 +130,40 @@ TEST_CASE( "spread_sorter tests", "[spread_sorter]" )
         cppsort::sort(cppsort::spread_sorter{}, std::begin(vec), std::end(vec), std::greater<>{});
         CHECK( std::is_sorted(std::begin(vec), std::end(vec), std::greater<>{}) );
     }
+
+    SECTION( "sort with wide strings" )
+    {
+        auto vec16 = wide_strings<std::u16string>(engine, { 0x41, 0x42, 0x7fff, 0x8000, 0xffff });
+        cppsort::sort(cppsort::spread_sorter{}, vec16);
+        CHECK( std::is_sorted(std::begin(vec16), std::end(vec16)) );
+
+        auto vec32 = wide_strings<std::u32string>(engine, { 0x41, 0x142, 0x10000, 0x10ffff, 0xffffffff });
+        cppsort::sort(cppsort::spread_sorter{}, std::begin(vec32), std::end(vec32));
+        CHECK( std::is_sorted(std::begin(vec32), std::end(vec32)) );
+
+        auto wvec = wide_strings<std::wstring>(engine, {
+            static_cast<wchar_t>(0x41), static_cast<wchar_t>(0x142),
+            static_cast<wchar_t>(0x7fff), static_cast<wchar_t>(-1)
+        });
+        cppsort::sort(cppsort::spread_sorter{}, wvec);
+        CHECK( std::is_sorted(std::begin(wvec), std::end(wvec)) );
+    }
+
+    SECTION( "reverse sort with wide strings" )
+    {
+        auto vec16 = wide_strings<std::u16string>(engine, { 0x41, 0x42, 0x7fff, 0x8000, 0xffff });
+        cppsort::sort(cppsort::spread_sorter{}, vec16, std::greater<>{});
+        CHECK( std::is_sorted(std::begin(vec16), std::end(vec16), std::greater<>{}) );
+
+        auto vec32 = wide_strings<std::u32string>(engine, { 0x41, 0x142, 0x10000, 0x10ffff, 0xffffffff });
+        cppsort::sort(cppsort::spread_sorter{}, std::begin(vec32), std::end(vec32), std::greater<>{});
+        CHECK( std::is_sorted(std::begin(vec32), std::end(vec32), std::greater<>{}) );
+
+        auto wvec = wide_strings<std::wstring>(engine, {
+            static_cast<wchar_t>(0x41), static_cast<wchar_t>(0x142),
+            static_cast<wchar_t>(0x7fff), static_cast<wchar_t>(-1)
+        });
+        cppsort::sort(cppsort::spread_sorter{}, wvec, std::greater<>{});
+        CHECK( std::is_sorted(std::begin(wvec), std::end(wvec), std::greater<>{}) );
+    }
 }
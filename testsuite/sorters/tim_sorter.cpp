@@ -0,0 +1,83 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <utility>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <cpp-sort/sorters/tim_sorter.h>
+#include <cpp-sort/sort.h>
+#include <cpp-sort/utility/merge_policies.h>
+
+TEMPLATE_TEST_CASE( "tim_sorter merge policies", "[tim_sorter]",
+                    cppsort::utility::timsort_merge_policy,
+                    cppsort::utility::powersort_merge_policy,
+                    cppsort::utility::kway_merge_policy<2>,
+                    cppsort::utility::kway_merge_policy<3>,
+                    cppsort::utility::kway_merge_policy<> )
+{
+    using sorter = cppsort::basic_tim_sorter<TestType>;
+
+    // Runs of uneven lengths with plenty of equivalent elements
+    std::mt19937 engine(Catch::rngSeed());
+    std::uniform_int_distribution<int> run_length(1, 700);
+    std::vector<std::pair<int, std::size_t>> collection;
+    while (collection.size() < 20'000) {
+        int length = run_length(engine);
+        for (int i = 0 ; i < length ; ++i) {
+            collection.emplace_back(i / 3, collection.size());
+        }
+    }
+    std::shuffle(std::begin(collection), std::begin(collection) + 500, engine);
+
+    auto expected = collection;
+    std::stable_sort(std::begin(expected), std::end(expected), [](const auto& lhs, const auto& rhs) {
+        return lhs.first < rhs.first;
+    });
+
+    SECTION( "stability" )
+    {
+        cppsort::sort(sorter{}, collection, &std::pair<int, std::size_t>::first);
+        CHECK( collection == expected );
+    }
+
+    SECTION( "stability with comparison" )
+    {
+        std::reverse(std::begin(expected), std::end(expected));
+        std::stable_sort(std::begin(expected), std::end(expected), [](const auto& lhs, const auto& rhs) {
+            return lhs.first > rhs.first;
+        });
+        std::reverse(std::begin(collection), std::end(collection));
+        cppsort::sort(sorter{}, collection, std::greater<>{}, &std::pair<int, std::size_t>::first);
+        CHECK( collection == expected );
+    }
+
+    SECTION( "is_always_stable" )
+    {
+        CHECK( cppsort::is_always_stable<sorter>::value );
+    }
+}
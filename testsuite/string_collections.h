@@ -0,0 +1,150 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef CPPSORT_TESTSUITE_STRING_COLLECTIONS_H_
+#define CPPSORT_TESTSUITE_STRING_COLLECTIONS_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include <catch2/catch.hpp>
+
+////////////////////////////////////////////////////////////
+// Collections of strings for the string sorters
+//
+// make_strings generates strings of various sizes made of few
+// different characters, including null characters, so that
+// many of them share long prefixes. naive_lcp computes the
+// longest common prefix of every string with the previous one,
+// which the sorters able to output an LCP array are checked
+// against.
+//
+
+inline auto make_strings(std::size_t size, std::size_t max_length)
+    -> std::vector<std::string>
+{
+    std::mt19937_64 engine(Catch::rngSeed());
+    std::uniform_int_distribution<std::size_t> length_dist(0, max_length);
+    const char chars[] = { '\0', 'a', 'b' };
+
+    std::vector<std::string> res;
+    for (std::size_t i = 0 ; i < size ; ++i) {
+        std::string str;
+        auto length = length_dist(engine);
+        for (std::size_t j = 0 ; j < length ; ++j) {
+            str.push_back(chars[engine() % 3]);
+        }
+        res.push_back(std::move(str));
+    }
+    return res;
+}
+
+inline auto naive_lcp(const std::vector<std::string>& strings)
+    -> std::vector<std::size_t>
+{
+    std::vector<std::size_t> res;
+    for (std::size_t i = 0 ; i < strings.size() ; ++i) {
+        if (i == 0) {
+            res.push_back(0);
+            continue;
+        }
+        auto& lhs = strings[i - 1];
+        auto& rhs = strings[i];
+        auto it = std::mismatch(lhs.begin(), lhs.begin() + std::min(lhs.size(), rhs.size()),
+                                rhs.begin());
+        res.push_back(it.first - lhs.begin());
+    }
+    return res;
+}
+
+////////////////////////////////////////////////////////////
+// Collections of strings for the string comparators
+//
+// make_mixed_case_strings generates long strings sharing long
+// prefixes that only differ by their case, with some non-ASCII
+// characters. make_natural_strings generates file names and
+// version strings with numbers of various sizes, sometimes with
+// leading zeros.
+//
+
+inline auto make_mixed_case_strings(std::size_t size)
+    -> std::vector<std::string>
+{
+    std::mt19937_64 engine(Catch::rngSeed());
+    const char chars[] = { 'a', 'A', 'b', 'B', 'z', 'Z', '[', '`', '\xe9', '\xc9' };
+
+    const std::string prefix = "the quick brown fox jumps over the lazy dog";
+
+    std::vector<std::string> res;
+    for (std::size_t i = 0 ; i < size ; ++i) {
+        std::string str = prefix.substr(0, engine() % prefix.size());
+        for (auto& c: str) {
+            if (engine() % 2 == 0 && c != ' ') {
+                c = static_cast<char>(c - 'a' + 'A');
+            }
+        }
+        auto length = engine() % 30;
+        for (std::size_t j = 0 ; j < length ; ++j) {
+            // Mostly letters, few non-ASCII characters
+            str.push_back(chars[engine() % (engine() % 8 == 0 ? 10 : 8)]);
+        }
+        res.push_back(std::move(str));
+    }
+    return res;
+}
+
+inline auto make_natural_strings(std::size_t size)
+    -> std::vector<std::string>
+{
+    std::mt19937_64 engine(Catch::rngSeed());
+    const char* parts[] = { "file", "v", ".", "-", "_", "a", "A", "\xe9" };
+
+    std::vector<std::string> res;
+    for (std::size_t i = 0 ; i < size ; ++i) {
+        std::string str;
+        auto nb_parts = engine() % 6;
+        for (std::size_t j = 0 ; j < nb_parts ; ++j) {
+            if (engine() % 2 == 0) {
+                str += parts[engine() % 8];
+            } else {
+                str += std::string(engine() % 3 == 0 ? engine() % 3 : 0, '0');
+                if (engine() % 10 == 0) {
+                    // Numbers longer than 255 digits
+                    str += std::string(300 + engine() % 2, '7');
+                } else {
+                    str += std::to_string(engine() % 1000);
+                }
+            }
+        }
+        res.push_back(std::move(str));
+    }
+    return res;
+}
+
+#endif // CPPSORT_TESTSUITE_STRING_COLLECTIONS_H_
@@ -0,0 +1,118 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <numeric>
+#include <string>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <cpp-sort/sorters/pdq_sorter.h>
+#include <cpp-sort/utility/apply_permutation.h>
+#include <cpp-sort/utility/argsort.h>
+#include "../distributions.h"
+#include "../move_only.h"
+
+TEST_CASE( "apply a permutation to several ranges",
+           "[utility][apply_permutation]" )
+{
+    std::vector<int> keys; keys.reserve(491);
+    auto distribution = dist::shuffled{};
+    distribution(std::back_inserter(keys), 491, -125);
+
+    std::vector<std::string> strings;
+    std::vector<double> doubles;
+    for (int key: keys) {
+        strings.push_back(std::to_string(key));
+        doubles.push_back(key * 0.5);
+    }
+
+    auto indices = cppsort::utility::argsort(cppsort::pdq_sort, keys);
+    const auto permutation = indices;
+
+    SECTION( "iterator interface" )
+    {
+        cppsort::utility::apply_permutation(std::begin(indices), std::end(indices),
+                                            std::begin(keys), std::begin(strings),
+                                            std::begin(doubles));
+        CHECK( indices == permutation );
+        CHECK( std::is_sorted(std::begin(keys), std::end(keys)) );
+        for (std::size_t i = 0 ; i < keys.size() ; ++i) {
+            CHECK( strings[i] == std::to_string(keys[i]) );
+            CHECK( doubles[i] == keys[i] * 0.5 );
+        }
+    }
+
+    SECTION( "iterable interface" )
+    {
+        cppsort::utility::apply_permutation(indices, keys, strings, doubles);
+        CHECK( indices == permutation );
+        CHECK( std::is_sorted(std::begin(keys), std::end(keys)) );
+        for (std::size_t i = 0 ; i < keys.size() ; ++i) {
+            CHECK( strings[i] == std::to_string(keys[i]) );
+            CHECK( doubles[i] == keys[i] * 0.5 );
+        }
+    }
+}
+
+TEST_CASE( "apply_permutation corner cases",
+           "[utility][apply_permutation]" )
+{
+    SECTION( "identity and signed indices" )
+    {
+        std::vector<int> indices(50);
+        std::iota(std::begin(indices), std::end(indices), 0);
+        std::vector<int> collection = indices;
+
+        cppsort::utility::apply_permutation(indices, collection);
+        CHECK( collection == indices );
+
+        std::reverse(std::begin(indices), std::end(indices));
+        cppsort::utility::apply_permutation(indices, collection);
+        CHECK( collection == indices );
+    }
+
+    SECTION( "move-only types" )
+    {
+        std::vector<std::uint32_t> indices = { 3, 0, 4, 1, 2 };
+        std::vector<move_only<int>> collection;
+        for (int i = 0 ; i < 5 ; ++i) {
+            collection.emplace_back(i);
+        }
+
+        cppsort::utility::apply_permutation(indices, collection);
+        for (int i = 0 ; i < 5 ; ++i) {
+            CHECK( collection[i].value == static_cast<int>(indices[i]) );
+        }
+    }
+
+    SECTION( "proxy iterators" )
+    {
+        std::vector<int> indices = { 1, 2, 0 };
+        std::vector<bool> collection = { true, false, false };
+
+        cppsort::utility::apply_permutation(indices, collection);
+        CHECK( collection == std::vector<bool>({ false, false, true }) );
+    }
+}
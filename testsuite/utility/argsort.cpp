@@ -0,0 +1,87 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <cpp-sort/sorters/merge_sorter.h>
+#include <cpp-sort/sorters/pdq_sorter.h>
+#include <cpp-sort/sorters/ska_sorter.h>
+#include <cpp-sort/utility/argsort.h>
+#include "../distributions.h"
+
+TEST_CASE( "basic tests with argsort",
+           "[utility][argsort]" )
+{
+    std::vector<int> collection; collection.reserve(491);
+    auto distribution = dist::shuffled{};
+    distribution(std::back_inserter(collection), 491, -125);
+    const auto original = collection;
+
+    SECTION( "without comparison nor projection" )
+    {
+        auto indices = cppsort::utility::argsort(cppsort::pdq_sort, collection);
+        CHECK( collection == original );
+        CHECK( std::is_sorted(std::begin(indices), std::end(indices), [&](auto lhs, auto rhs) {
+            return collection[lhs] < collection[rhs];
+        }) );
+    }
+
+    SECTION( "with comparison and projection" )
+    {
+        auto indices = cppsort::utility::argsort(
+            cppsort::ska_sort, std::begin(collection), std::end(collection),
+            std::less<>{}, std::negate<>{}
+        );
+        CHECK( collection == original );
+        CHECK( std::is_sorted(std::begin(indices), std::end(indices), [&](auto lhs, auto rhs) {
+            return collection[lhs] > collection[rhs];
+        }) );
+    }
+
+    SECTION( "with a custom index type" )
+    {
+        auto indices = cppsort::utility::argsort<std::uint32_t>(cppsort::pdq_sort, collection,
+                                                                std::greater<>{});
+        CHECK( std::is_sorted(std::begin(indices), std::end(indices), [&](auto lhs, auto rhs) {
+            return collection[lhs] > collection[rhs];
+        }) );
+    }
+}
+
+TEST_CASE( "argsort with a stable sorter",
+           "[utility][argsort][is_stable]" )
+{
+    std::vector<int> collection; collection.reserve(500);
+    auto distribution = dist::shuffled_16_values{};
+    distribution(std::back_inserter(collection), 500);
+
+    auto indices = cppsort::utility::argsort(cppsort::merge_sort, collection);
+    CHECK( std::is_sorted(std::begin(indices), std::end(indices), [&](auto lhs, auto rhs) {
+        return collection[lhs] < collection[rhs]
+            || (collection[lhs] == collection[rhs] && lhs < rhs);
+    }) );
+}
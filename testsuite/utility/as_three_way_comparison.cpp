@@ -0,0 +1,145 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <random>
+#include <string>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <cpp-sort/sorters/grail_sorter.h>
+#include <cpp-sort/sorters/quick_sorter.h>
+#include <cpp-sort/sorters/tim_sorter.h>
+#include <cpp-sort/utility/functional.h>
+
+namespace
+{
+    // Strings sharing a long common prefix
+    auto make_strings(std::size_t size)
+        -> std::vector<std::string>
+    {
+        std::mt19937_64 engine(Catch::rngSeed());
+        std::vector<std::string> res;
+        for (std::size_t i = 0 ; i < size ; ++i) {
+            res.push_back("some/long/common/prefix/" + std::to_string(engine() % 100));
+        }
+        return res;
+    }
+
+    // Counts the self-move-assignments, which sorters must avoid
+    struct self_move_counter
+    {
+        int value;
+        int* self_moves;
+
+        self_move_counter(int value, int* self_moves):
+            value(value),
+            self_moves(self_moves)
+        {}
+
+        self_move_counter(self_move_counter&&) = default;
+
+        auto operator=(self_move_counter&& other)
+            -> self_move_counter&
+        {
+            if (this == &other) {
+                ++*self_moves;
+            }
+            value = other.value;
+            self_moves = other.self_moves;
+            return *this;
+        }
+    };
+}
+
+TEST_CASE( "sorters with a three-way comparison",
+           "[utility][as_three_way_comparison]" )
+{
+    int three_way_calls = 0;
+    auto compare = cppsort::utility::as_three_way_comparison(
+        [&](const std::string& lhs, const std::string& rhs) {
+            ++three_way_calls;
+            return lhs.compare(rhs);
+        }
+    );
+
+    auto strings = make_strings(1000);
+
+    SECTION( "comparison function" )
+    {
+        CHECK( compare(std::string("a"), std::string("b")) );
+        CHECK_FALSE( compare(std::string("b"), std::string("a")) );
+        CHECK_FALSE( compare(std::string("a"), std::string("a")) );
+        CHECK( compare.three_way(std::string("a"), std::string("a")) == 0 );
+    }
+
+    SECTION( "quick_sorter with forward iterators" )
+    {
+        std::list<std::string> collection(std::begin(strings), std::end(strings));
+        cppsort::quick_sort(collection, compare);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+        CHECK( three_way_calls > 0 );
+    }
+
+    SECTION( "quick_sorter without self-move" )
+    {
+        int self_moves = 0;
+        std::mt19937_64 engine(Catch::rngSeed());
+        std::list<self_move_counter> collection;
+        for (int i = 0 ; i < 2000 ; ++i) {
+            collection.emplace_back(static_cast<int>(engine() % 50), &self_moves);
+        }
+
+        auto value_compare = cppsort::utility::as_three_way_comparison(
+            [](const self_move_counter& lhs, const self_move_counter& rhs) {
+                return lhs.value - rhs.value;
+            }
+        );
+        cppsort::quick_sort(collection, value_compare);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection), value_compare) );
+        CHECK( self_moves == 0 );
+    }
+
+    SECTION( "quick_sorter with std::less<>" )
+    {
+        std::list<std::string> collection(std::begin(strings), std::end(strings));
+        cppsort::quick_sort(collection);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+    }
+
+    SECTION( "grail_sorter" )
+    {
+        auto collection = strings;
+        cppsort::grail_sort(collection, compare);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+        CHECK( three_way_calls > 0 );
+    }
+
+    SECTION( "tim_sorter" )
+    {
+        auto collection = strings;
+        cppsort::tim_sort(collection, compare);
+        CHECK( std::is_sorted(std::begin(collection), std::end(collection)) );
+    }
+}
@@ -0,0 +1,108 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <cpp-sort/utility/lazy_sorted_view.h>
+#include "../algorithm.h"
+#include "../distributions.h"
+
+TEST_CASE( "lazy_sorted_view sequential access",
+           "[utility][lazy_sorted_view]" )
+{
+    std::vector<int> collection; collection.reserve(1000);
+    auto distribution = dist::shuffled{};
+    distribution(std::back_inserter(collection), 1000, -350);
+
+    auto expected = collection;
+    std::sort(std::begin(expected), std::end(expected));
+
+    SECTION( "first elements only" )
+    {
+        auto view = cppsort::utility::make_lazy_sorted_view(collection);
+        CHECK( std::equal(view.begin(), view.begin() + 30, std::begin(expected)) );
+        for (int i = 0 ; i < 30 ; ++i) {
+            CHECK( view.is_sorted(i) );
+        }
+        CHECK( not std::is_sorted(std::begin(collection), std::end(collection)) );
+    }
+
+    SECTION( "whole view" )
+    {
+        auto view = cppsort::utility::make_lazy_sorted_view(collection);
+        CHECK( std::equal(view.begin(), view.end(), std::begin(expected), std::end(expected)) );
+        CHECK( collection == expected );
+    }
+
+    SECTION( "with comparison and projection" )
+    {
+        auto view = cppsort::utility::make_lazy_sorted_view(
+            std::begin(collection), std::end(collection),
+            std::greater<>{}, std::negate<>{}
+        );
+        CHECK( std::equal(view.begin(), view.end(), std::begin(expected), std::end(expected)) );
+    }
+}
+
+TEST_CASE( "lazy_sorted_view random access",
+           "[utility][lazy_sorted_view]" )
+{
+    std::vector<int> collection; collection.reserve(1000);
+    auto distribution = dist::shuffled{};
+    distribution(std::back_inserter(collection), 1000, -350);
+
+    auto expected = collection;
+    std::sort(std::begin(expected), std::end(expected));
+
+    auto view = cppsort::utility::make_lazy_sorted_view(collection);
+    CHECK( view[500] == expected[500] );
+    CHECK( view[999] == expected[999] );
+    CHECK( view[0] == expected[0] );
+    CHECK( view.is_sorted(500) );
+    CHECK( view.begin()[250] == expected[250] );
+    CHECK( *(view.end() - 10) == expected[990] );
+
+    // Previously sorted elements don't move anymore
+    CHECK( collection[500] == expected[500] );
+    CHECK( collection[250] == expected[250] );
+
+    CHECK( std::equal(view.begin(), view.end(), std::begin(expected), std::end(expected)) );
+}
+
+TEST_CASE( "lazy_sorted_view with many equal elements",
+           "[utility][lazy_sorted_view]" )
+{
+    std::vector<int> collection; collection.reserve(1000);
+    auto distribution = dist::shuffled_16_values{};
+    distribution(std::back_inserter(collection), 1000);
+
+    auto expected = collection;
+    std::sort(std::begin(expected), std::end(expected));
+
+    auto view = cppsort::utility::make_lazy_sorted_view(collection);
+    CHECK( view[700] == expected[700] );
+    CHECK( std::equal(view.begin(), view.end(), std::begin(expected), std::end(expected)) );
+}
@@ -0,0 +1,156 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <tuple>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <cpp-sort/sorters/ska_sorter.h>
+#include <cpp-sort/sorters/spread_sorter.h>
+#include <cpp-sort/utility/radix_key.h>
+
+namespace
+{
+    struct record
+    {
+        std::uint32_t tenant;
+        std::int64_t timestamp;
+        std::uint64_t id;
+    };
+
+    // Tenants ascending, most recent events first, then ids
+    auto radix_key(const record& rec)
+        -> decltype(auto)
+    {
+        using cppsort::utility::make_radix_key;
+        using cppsort::utility::descending;
+        return make_radix_key(rec.tenant, descending(rec.timestamp), rec.id);
+    }
+
+    auto record_less(const record& lhs, const record& rhs)
+        -> bool
+    {
+        if (lhs.tenant != rhs.tenant) return lhs.tenant < rhs.tenant;
+        if (lhs.timestamp != rhs.timestamp) return lhs.timestamp > rhs.timestamp;
+        return lhs.id < rhs.id;
+    }
+
+    auto same_order(const std::vector<record>& lhs, const std::vector<record>& rhs)
+        -> bool
+    {
+        return std::equal(lhs.begin(), lhs.end(), rhs.begin(), [](const record& x, const record& y) {
+            return x.tenant == y.tenant && x.timestamp == y.timestamp && x.id == y.id;
+        });
+    }
+
+    auto make_records(std::size_t size)
+        -> std::vector<record>
+    {
+        std::mt19937_64 engine(Catch::rngSeed());
+        std::vector<record> res;
+        for (std::size_t i = 0 ; i < size ; ++i) {
+            res.push_back({
+                static_cast<std::uint32_t>(engine() % 8),
+                static_cast<std::int64_t>(engine() % 200) - 100,
+                engine()
+            });
+        }
+        return res;
+    }
+}
+
+TEST_CASE( "make_radix_key fields order", "[utility][radix_key]" )
+{
+    using cppsort::utility::make_radix_key;
+    using cppsort::utility::descending;
+
+    CHECK( make_radix_key(-1, 5u) < make_radix_key(0, 4u) );
+    CHECK( make_radix_key(descending(-1), 5u) > make_radix_key(descending(0), 4u) );
+    CHECK( make_radix_key(-0.0, 1) < make_radix_key(0.0, 0) );
+    CHECK( make_radix_key(std::int8_t(-128)) < make_radix_key(std::int8_t(127)) );
+    CHECK( std::get<0>(make_radix_key(std::int16_t(-1))) == 0x7FFFu );
+}
+
+TEST_CASE( "radix sorters with composite keys", "[utility][radix_key]" )
+{
+    auto collection = make_records(50'000);
+    auto expected = collection;
+    std::sort(expected.begin(), expected.end(), record_less);
+
+    SECTION( "ska_sorter with a radix_key function" )
+    {
+        cppsort::ska_sort(collection);
+        CHECK( same_order(collection, expected) );
+    }
+
+    SECTION( "spread_sorter with a radix_key function" )
+    {
+        // 160 bits: sorted through byte strings
+        cppsort::spread_sort(collection);
+        CHECK( same_order(collection, expected) );
+    }
+
+    SECTION( "spread_sorter with a projection" )
+    {
+        // 64 bits: packed into a single integer
+        auto proj = [](const record& rec) {
+            using cppsort::utility::make_radix_key;
+            using cppsort::utility::descending;
+            return make_radix_key(static_cast<std::uint16_t>(rec.tenant),
+                                  descending(static_cast<std::int16_t>(rec.timestamp)),
+                                  static_cast<std::uint32_t>(rec.id));
+        };
+        cppsort::spread_sort(collection, proj);
+        CHECK( std::is_sorted(collection.begin(), collection.end(), [&](auto& lhs, auto& rhs) {
+            return proj(lhs) < proj(rhs);
+        }) );
+    }
+
+    SECTION( "mixed floating point fields" )
+    {
+        std::vector<std::tuple<double, int>> values;
+        for (auto& rec: collection) {
+            values.emplace_back(static_cast<double>(rec.timestamp) / 3.0, static_cast<int>(rec.id % 100));
+        }
+        auto proj = [](const std::tuple<double, int>& value) {
+            using cppsort::utility::make_radix_key;
+            using cppsort::utility::descending;
+            return make_radix_key(std::get<0>(value), descending(std::get<1>(value)));
+        };
+        auto expected_values = values;
+        std::sort(expected_values.begin(), expected_values.end(), [](auto& lhs, auto& rhs) {
+            if (std::get<0>(lhs) != std::get<0>(rhs)) return std::get<0>(lhs) < std::get<0>(rhs);
+            return std::get<1>(lhs) > std::get<1>(rhs);
+        });
+
+        auto ska_values = values;
+        cppsort::ska_sort(ska_values, proj);
+        CHECK( ska_values == expected_values );
+
+        cppsort::spread_sort(values, proj);
+        CHECK( values == expected_values );
+    }
+}
@@ -0,0 +1,124 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <cpp-sort/sorters/merge_sorter.h>
+#include <cpp-sort/sorters/pdq_sorter.h>
+#include <cpp-sort/sorters/ska_sorter.h>
+#include <cpp-sort/sorters/spread_sorter.h>
+#include <cpp-sort/utility/sort_by_key.h>
+#include "../distributions.h"
+
+namespace
+{
+    // Payload too big to be carried along with the keys
+    struct payload
+    {
+        std::int64_t key;
+        std::array<std::int64_t, 3> data;
+    };
+}
+
+TEMPLATE_TEST_CASE( "sort_by_key with radix sorters", "[utility][sort_by_key]",
+                    cppsort::ska_sorter,
+                    cppsort::spread_sorter )
+{
+    std::vector<std::int64_t> keys; keys.reserve(491);
+    auto distribution = dist::shuffled{};
+    distribution(std::back_inserter(keys), 491, -125);
+
+    SECTION( "small values" )
+    {
+        std::vector<std::int32_t> values(std::begin(keys), std::end(keys));
+        cppsort::utility::sort_by_key(TestType{}, keys, values);
+        CHECK( std::is_sorted(std::begin(keys), std::end(keys)) );
+        CHECK( std::equal(std::begin(keys), std::end(keys), std::begin(values)) );
+    }
+
+    SECTION( "big values" )
+    {
+        std::vector<payload> values;
+        for (auto key: keys) {
+            values.push_back({ key, {{ key, 2 * key, 3 * key }} });
+        }
+        cppsort::utility::sort_by_key(TestType{}, keys, values);
+        CHECK( std::is_sorted(std::begin(keys), std::end(keys)) );
+        for (std::size_t i = 0 ; i < keys.size() ; ++i) {
+            CHECK( values[i].key == keys[i] );
+            CHECK( values[i].data[2] == 3 * keys[i] );
+        }
+    }
+
+    SECTION( "with projection" )
+    {
+        std::vector<std::string> values;
+        for (auto key: keys) {
+            values.push_back(std::to_string(key));
+        }
+        cppsort::utility::sort_by_key(TestType{}, std::begin(keys), std::end(keys),
+                                      std::begin(values), std::less<>{}, std::negate<>{});
+        CHECK( std::is_sorted(std::begin(keys), std::end(keys), std::greater<>{}) );
+        for (std::size_t i = 0 ; i < keys.size() ; ++i) {
+            CHECK( values[i] == std::to_string(keys[i]) );
+        }
+    }
+}
+
+TEST_CASE( "sort_by_key with comparison sorters", "[utility][sort_by_key]" )
+{
+    std::vector<int> keys; keys.reserve(491);
+    auto distribution = dist::shuffled_16_values{};
+    distribution(std::back_inserter(keys), 491);
+
+    std::vector<std::string> values;
+    for (std::size_t i = 0 ; i < keys.size() ; ++i) {
+        values.push_back(std::to_string(keys[i]) + '/' + std::to_string(i));
+    }
+    auto expected = values;
+    std::stable_sort(std::begin(expected), std::end(expected), [](const auto& lhs, const auto& rhs) {
+        return std::stoi(lhs) > std::stoi(rhs);
+    });
+
+    SECTION( "stable sorter" )
+    {
+        cppsort::utility::sort_by_key(cppsort::merge_sort, keys, values, std::greater<>{});
+        CHECK( std::is_sorted(std::begin(keys), std::end(keys), std::greater<>{}) );
+        CHECK( values == expected );
+    }
+
+    SECTION( "unstable sorter" )
+    {
+        cppsort::utility::sort_by_key(cppsort::pdq_sort, keys, values, std::greater<>{});
+        CHECK( std::is_sorted(std::begin(keys), std::end(keys), std::greater<>{}) );
+        for (std::size_t i = 0 ; i < keys.size() ; ++i) {
+            CHECK( std::stoi(values[i]) == keys[i] );
+        }
+    }
+}
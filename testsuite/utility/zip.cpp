@@ -0,0 +1,117 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Morwenn
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <cpp-sort/sort.h>
+#include <cpp-sort/sorters.h>
+#include <cpp-sort/utility/buffer.h>
+#include <cpp-sort/utility/zip.h>
+#include "../distributions.h"
+
+namespace
+{
+    struct first_column
+    {
+        template<typename T>
+        auto operator()(T&& value) const
+            -> decltype(auto)
+        {
+            return std::get<0>(std::forward<T>(value));
+        }
+    };
+}
+
+TEMPLATE_TEST_CASE( "test every sorter with zip ranges", "[utility][zip]",
+                    cppsort::block_sorter<>,
+                    cppsort::default_sorter,
+                    cppsort::drop_merge_sorter,
+                    cppsort::grail_sorter<>,
+                    cppsort::heap_sorter,
+                    cppsort::insertion_sorter,
+                    cppsort::ips4o_sorter<>,
+                    cppsort::merge_insertion_sorter,
+                    cppsort::merge_sorter,
+                    cppsort::pdq_sorter,
+                    cppsort::poplar_sorter,
+                    cppsort::quad_sorter<>,
+                    cppsort::quick_merge_sorter,
+                    cppsort::quick_sorter,
+                    cppsort::samplesort_sorter<>,
+                    cppsort::selection_sorter,
+                    cppsort::smooth_sorter,
+                    cppsort::std_sorter,
+                    cppsort::tim_sorter,
+                    cppsort::verge_sorter )
+{
+    std::vector<int> keys; keys.reserve(491);
+    auto distribution = dist::shuffled{};
+    distribution(std::back_inserter(keys), 491, -125);
+
+    std::vector<std::string> values;
+    for (int key: keys) {
+        values.push_back(std::to_string(key));
+    }
+
+    using sorter = TestType;
+
+    SECTION( "without projection" )
+    {
+        cppsort::sort(sorter{}, cppsort::utility::zip(keys, values));
+        CHECK( std::is_sorted(std::begin(keys), std::end(keys)) );
+        for (std::size_t i = 0 ; i < keys.size() ; ++i) {
+            CHECK( values[i] == std::to_string(keys[i]) );
+        }
+    }
+
+    SECTION( "with projection" )
+    {
+        cppsort::sort(sorter{}, cppsort::utility::zip(keys, values), std::greater<>{}, first_column{});
+        CHECK( std::is_sorted(std::begin(keys), std::end(keys), std::greater<>{}) );
+        for (std::size_t i = 0 ; i < keys.size() ; ++i) {
+            CHECK( values[i] == std::to_string(keys[i]) );
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE( "test radix sorters with zip ranges", "[utility][zip]",
+                    cppsort::ska_sorter,
+                    cppsort::spread_sorter )
+{
+    std::vector<int> keys; keys.reserve(491);
+    auto distribution = dist::shuffled{};
+    distribution(std::back_inserter(keys), 491, -125);
+
+    std::vector<long long int> values(std::begin(keys), std::end(keys));
+    std::vector<double> others(std::begin(keys), std::end(keys));
+
+    using sorter = TestType;
+    cppsort::sort(sorter{}, cppsort::utility::zip(keys, values, others), first_column{});
+    CHECK( std::is_sorted(std::begin(keys), std::end(keys)) );
+    CHECK( std::is_sorted(std::begin(values), std::end(values)) );
+    CHECK( std::is_sorted(std::begin(others), std::end(others)) );
+}